@@ -0,0 +1,191 @@
+#include "battle_simulator.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "parallel_for.hpp"
+
+namespace {
+
+using uni_course_cpp::FighterStats;
+
+static constexpr int kBatchSize = 256;
+static constexpr size_t kCacheLineSize = 64;
+static constexpr int kMaxRoundsCount = 64;
+static constexpr int kAliveCheckRoundsStep = 8;
+static constexpr float kStaminaPerAttack = 1.0f;
+static constexpr float kMinAttackFactor = 0.5f;
+static constexpr float kRandomNumberScale = 1.0f / 16777216.0f;
+
+struct alignas(kCacheLineSize) BatchResult {
+  int64_t wins_count = 0;
+  double total_damage = 0;
+};
+
+struct FightBatch {
+  std::array<float, kBatchSize> knight_health;
+  std::array<float, kBatchSize> knight_stamina;
+  std::array<float, kBatchSize> enemy_health;
+  std::array<float, kBatchSize> enemy_stamina;
+  std::array<uint32_t, kBatchSize> random_states;
+};
+
+uint32_t next_random_state(uint32_t state) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+float random_state_to_unit(uint32_t state) {
+  return (state >> 8) * kRandomNumberScale;
+}
+
+void reset_batch(FightBatch& batch,
+                 const FighterStats& knight_stats,
+                 const FighterStats& enemy_stats,
+                 std::mt19937& gen) {
+  batch.knight_health.fill(knight_stats.health());
+  batch.knight_stamina.fill(knight_stats.stamina());
+  batch.enemy_health.fill(enemy_stats.health());
+  batch.enemy_stamina.fill(enemy_stats.stamina());
+  for (auto& random_state : batch.random_states) {
+    random_state = gen() | 1u;
+  }
+}
+
+bool has_active_fights(const FightBatch& batch) {
+  for (int i = 0; i < kBatchSize; ++i) {
+    if (batch.knight_health[i] > 0 && batch.enemy_health[i] > 0)
+      return true;
+  }
+  return false;
+}
+
+void simulate_round(FightBatch& batch,
+                    const FighterStats& knight_stats,
+                    const FighterStats& enemy_stats) {
+  const float knight_stamina_scale =
+      knight_stats.stamina() > 0
+          ? (1.0f - kMinAttackFactor) / knight_stats.stamina()
+          : 0.0f;
+  const float enemy_stamina_scale =
+      enemy_stats.stamina() > 0
+          ? (1.0f - kMinAttackFactor) / enemy_stats.stamina()
+          : 0.0f;
+
+  float* const knight_health = batch.knight_health.data();
+  float* const knight_stamina = batch.knight_stamina.data();
+  float* const enemy_health = batch.enemy_health.data();
+  float* const enemy_stamina = batch.enemy_stamina.data();
+  uint32_t* const random_states = batch.random_states.data();
+
+  for (int i = 0; i < kBatchSize; ++i) {
+    const float is_active =
+        ((knight_health[i] > 0) & (enemy_health[i] > 0)) ? 1.0f : 0.0f;
+
+    const uint32_t knight_state = next_random_state(random_states[i]);
+    const uint32_t enemy_state = next_random_state(knight_state);
+    random_states[i] = enemy_state;
+
+    const float knight_hit =
+        knight_stats.attack() *
+        (kMinAttackFactor + knight_stamina[i] * knight_stamina_scale) *
+        random_state_to_unit(knight_state);
+    enemy_health[i] -= is_active * knight_hit;
+
+    const float is_enemy_alive = enemy_health[i] > 0 ? 1.0f : 0.0f;
+    const float enemy_hit =
+        enemy_stats.attack() *
+        (kMinAttackFactor + enemy_stamina[i] * enemy_stamina_scale) *
+        random_state_to_unit(enemy_state);
+    knight_health[i] -= is_active * is_enemy_alive * enemy_hit;
+
+    knight_stamina[i] =
+        std::max(0.0f, knight_stamina[i] - is_active * kStaminaPerAttack);
+    enemy_stamina[i] = std::max(
+        0.0f, enemy_stamina[i] - is_active * is_enemy_alive * kStaminaPerAttack);
+  }
+}
+
+BatchResult simulate_batch(FightBatch& batch,
+                           const FighterStats& knight_stats,
+                           const FighterStats& enemy_stats,
+                           int fights_count) {
+  for (int round = 0; round < kMaxRoundsCount; ++round) {
+    if (round % kAliveCheckRoundsStep == 0 && !has_active_fights(batch))
+      break;
+    simulate_round(batch, knight_stats, enemy_stats);
+  }
+
+  BatchResult result;
+  for (int i = 0; i < fights_count; ++i) {
+    if (batch.knight_health[i] > 0 && batch.enemy_health[i] <= 0) {
+      ++result.wins_count;
+    }
+    result.total_damage +=
+        knight_stats.health() - std::max(0.0f, batch.knight_health[i]);
+  }
+  return result;
+}
+
+}  // namespace
+
+namespace uni_course_cpp {
+
+BattleOutcome BattleSimulator::simulate(const FighterStats& knight_stats,
+                                        EnemyType enemy_type) const {
+  const int fights_count = params_.fights_count();
+  if (fights_count <= 0)
+    return BattleOutcome();
+
+  const auto enemy_stats = get_enemy_stats(enemy_type);
+  const int batches_count = (fights_count + kBatchSize - 1) / kBatchSize;
+  const int threads_count = std::max(1, params_.threads_count());
+  auto thread_results = std::vector<BatchResult>(threads_count);
+
+  parallel_for(
+      0, batches_count, threads_count,
+      [&thread_results, &knight_stats, &enemy_stats, fights_count](
+          int thread_index, int batch_begin, int batch_end) {
+        std::random_device rd;
+        std::mt19937 gen(rd());
+        FightBatch batch;
+        auto& thread_result = thread_results[thread_index];
+        for (int batch_index = batch_begin; batch_index < batch_end;
+             ++batch_index) {
+          reset_batch(batch, knight_stats, enemy_stats, gen);
+          const int batch_fights_count =
+              std::min(kBatchSize, fights_count - batch_index * kBatchSize);
+          const auto batch_result = simulate_batch(
+              batch, knight_stats, enemy_stats, batch_fights_count);
+          thread_result.wins_count += batch_result.wins_count;
+          thread_result.total_damage += batch_result.total_damage;
+        }
+      });
+
+  BatchResult total_result;
+  for (const auto& thread_result : thread_results) {
+    total_result.wins_count += thread_result.wins_count;
+    total_result.total_damage += thread_result.total_damage;
+  }
+
+  BattleOutcome outcome;
+  outcome.win_probability =
+      static_cast<float>(total_result.wins_count) / fights_count;
+  outcome.expected_damage =
+      static_cast<float>(total_result.total_damage / fights_count);
+  return outcome;
+}
+
+BattleTable BattleSimulator::simulate_all(
+    const FighterStats& knight_stats) const {
+  BattleTable battle_table;
+  for (const auto enemy_type : kAllEnemyTypes) {
+    battle_table[enemy_type] = simulate(knight_stats, enemy_type);
+  }
+  return battle_table;
+}
+
+}  // namespace uni_course_cpp
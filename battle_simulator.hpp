@@ -0,0 +1,39 @@
+#pragma once
+
+#include <unordered_map>
+#include "fighter.hpp"
+
+namespace uni_course_cpp {
+
+struct BattleOutcome {
+  float win_probability = 0;
+  float expected_damage = 0;
+};
+
+using BattleTable = std::unordered_map<EnemyType, BattleOutcome>;
+
+class BattleSimulator {
+ public:
+  struct Params {
+   public:
+    Params(int fights_count, int threads_count)
+        : fights_count_(fights_count), threads_count_(threads_count) {}
+    int fights_count() const { return fights_count_; }
+    int threads_count() const { return threads_count_; }
+
+   private:
+    int fights_count_ = 0;
+    int threads_count_ = 0;
+  };
+
+  explicit BattleSimulator(Params&& params) : params_(std::move(params)) {}
+
+  BattleOutcome simulate(const FighterStats& knight_stats,
+                         EnemyType enemy_type) const;
+  BattleTable simulate_all(const FighterStats& knight_stats) const;
+
+ private:
+  Params params_ = Params(0, 0);
+};
+
+}  // namespace uni_course_cpp
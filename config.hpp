@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 namespace uni_course_cpp {
@@ -8,6 +9,34 @@ namespace config {
 const std::string kTempDirectoryPath = "./temp/";
 const std::string kLogFilename = "log.txt";
 const std::string kLogFilePath = kTempDirectoryPath + kLogFilename;
+constexpr bool kHeapTrackingEnabled = false;
+constexpr bool kRenumberVerticesByDepth = true;
+constexpr bool kGraphReplayCacheEnabled = false;
+const std::string kGraphReplayCacheDirectoryPath =
+    kTempDirectoryPath + "graph_replay_cache/";
+constexpr size_t kGraphReplayCacheMaxSizeBytes = 256 * 1024 * 1024;
+constexpr bool kPinWorkersToNumaNodes = true;
+constexpr bool kCompressGraphOutput = false;
+constexpr bool kMetricsEnabled = false;
+const std::string kMetricsFilePath = kTempDirectoryPath + "metrics.prom";
+constexpr int kMetricsExportPeriodMs = 1000;
+constexpr int kJobTimeLimitMs = 0;
+constexpr int kJobMaxVerticesCount = 0;
+constexpr int kJobMaxEdgesCount = 0;
+constexpr bool kLargeGraphModeEnabled = false;
+const std::string kLargeGraphDirectoryPath =
+    kTempDirectoryPath + "large_graphs/";
+constexpr bool kSharedMemoryOutputEnabled = false;
+const std::string kSharedGraphQueueName = "/uni_course_cpp_graphs";
+const std::string kSharedGraphNamePrefix = "/uni_course_cpp_graph_";
+constexpr int kSharedGraphQueueCapacity = 64;
+constexpr bool kHeterogeneousBatchEnabled = false;
+constexpr int kHeterogeneousBatchDepthsCount = 3;
+constexpr int kBattleFightsCount = 10000;
+constexpr bool kKnightOptimizationEnabled = false;
+constexpr int kKnightOptimizationGenerationsCount = 8;
+constexpr int kKnightOptimizationPopulationSize = 32;
+constexpr int kKnightOptimizationFightsCount = 2000;
 
 }  // namespace config
 }  // namespace uni_course_cpp
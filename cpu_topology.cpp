@@ -0,0 +1,152 @@
+#include "cpu_topology.hpp"
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+
+const std::string kNumaNodesDirectoryPath = "/sys/devices/system/node/";
+const std::string kNumaNodeDirectoryPrefix = "node";
+const std::string kCpuListFileName = "cpulist";
+static constexpr int kBitsPerMaskWord = 8 * sizeof(unsigned long);
+
+std::vector<int> parse_cpu_list(const std::string& cpu_list) {
+  std::vector<int> cpu_ids;
+  std::stringstream cpu_list_stream(cpu_list);
+  std::string cpu_range;
+  while (std::getline(cpu_list_stream, cpu_range, ',')) {
+    if (cpu_range.empty() || cpu_range == "\n")
+      continue;
+    const auto dash_position = cpu_range.find('-');
+    const int first_cpu_id = std::stoi(cpu_range.substr(0, dash_position));
+    const int last_cpu_id =
+        dash_position == std::string::npos
+            ? first_cpu_id
+            : std::stoi(cpu_range.substr(dash_position + 1));
+    for (int cpu_id = first_cpu_id; cpu_id <= last_cpu_id; ++cpu_id) {
+      cpu_ids.push_back(cpu_id);
+    }
+  }
+  return cpu_ids;
+}
+
+std::vector<uni_course_cpp::NumaNode> read_numa_nodes() {
+  std::vector<uni_course_cpp::NumaNode> numa_nodes;
+  std::error_code error_code;
+  for (const auto& directory_entry : std::filesystem::directory_iterator(
+           kNumaNodesDirectoryPath, error_code)) {
+    const auto directory_name = directory_entry.path().filename().string();
+    if (directory_name.rfind(kNumaNodeDirectoryPrefix, 0) != 0 ||
+        directory_name.size() == kNumaNodeDirectoryPrefix.size() ||
+        !std::all_of(directory_name.cbegin() + kNumaNodeDirectoryPrefix.size(),
+                     directory_name.cend(), ::isdigit))
+      continue;
+
+    std::ifstream cpu_list_file(directory_entry.path() / kCpuListFileName);
+    std::string cpu_list;
+    std::getline(cpu_list_file, cpu_list);
+    uni_course_cpp::NumaNode numa_node;
+    numa_node.id =
+        std::stoi(directory_name.substr(kNumaNodeDirectoryPrefix.size()));
+    numa_node.cpu_ids = parse_cpu_list(cpu_list);
+    if (!numa_node.cpu_ids.empty()) {
+      numa_nodes.push_back(std::move(numa_node));
+    }
+  }
+  std::sort(numa_nodes.begin(), numa_nodes.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.id < rhs.id; });
+  return numa_nodes;
+}
+
+std::optional<cpu_set_t> get_allowed_cpu_set() {
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) != 0)
+    return std::nullopt;
+  return cpu_set;
+}
+
+std::vector<int> filter_allowed_cpu_ids(
+    const std::vector<int>& cpu_ids,
+    const std::optional<cpu_set_t>& allowed_cpu_set) {
+  if (!allowed_cpu_set)
+    return cpu_ids;
+  std::vector<int> allowed_cpu_ids;
+  for (const auto cpu_id : cpu_ids) {
+    if (cpu_id >= 0 && cpu_id < CPU_SETSIZE &&
+        CPU_ISSET(cpu_id, &*allowed_cpu_set)) {
+      allowed_cpu_ids.push_back(cpu_id);
+    }
+  }
+  return allowed_cpu_ids;
+}
+
+}  // namespace
+
+namespace uni_course_cpp {
+
+std::vector<NumaNode> get_numa_nodes() {
+  const auto allowed_cpu_set = get_allowed_cpu_set();
+  std::vector<NumaNode> numa_nodes;
+  for (auto& numa_node : read_numa_nodes()) {
+    numa_node.cpu_ids =
+        filter_allowed_cpu_ids(numa_node.cpu_ids, allowed_cpu_set);
+    if (!numa_node.cpu_ids.empty()) {
+      numa_nodes.push_back(std::move(numa_node));
+    }
+  }
+  if (!numa_nodes.empty())
+    return numa_nodes;
+
+  NumaNode numa_node;
+  if (allowed_cpu_set) {
+    for (int cpu_id = 0; cpu_id < CPU_SETSIZE; ++cpu_id) {
+      if (CPU_ISSET(cpu_id, &*allowed_cpu_set)) {
+        numa_node.cpu_ids.push_back(cpu_id);
+      }
+    }
+  }
+  if (numa_node.cpu_ids.empty()) {
+    const int cpus_count = std::max(1u, std::thread::hardware_concurrency());
+    for (int cpu_id = 0; cpu_id < cpus_count; ++cpu_id) {
+      numa_node.cpu_ids.push_back(cpu_id);
+    }
+  }
+  return {numa_node};
+}
+
+bool pin_current_thread(const std::vector<int>& cpu_ids) {
+  if (cpu_ids.empty())
+    return false;
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const auto cpu_id : cpu_ids) {
+    if (cpu_id >= 0 && cpu_id < CPU_SETSIZE) {
+      CPU_SET(cpu_id, &cpu_set);
+    }
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) ==
+         0;
+}
+
+bool prefer_numa_node_memory(int numa_node_id) {
+  if (numa_node_id < 0)
+    return false;
+  auto node_mask =
+      std::vector<unsigned long>(numa_node_id / kBitsPerMaskWord + 1, 0);
+  node_mask[numa_node_id / kBitsPerMaskWord] |=
+      1ul << (numa_node_id % kBitsPerMaskWord);
+  return syscall(SYS_set_mempolicy, MPOL_PREFERRED, node_mask.data(),
+                 node_mask.size() * kBitsPerMaskWord + 1) == 0;
+}
+
+}  // namespace uni_course_cpp
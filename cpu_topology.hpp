@@ -0,0 +1,16 @@
+#pragma once
+
+#include <vector>
+
+namespace uni_course_cpp {
+
+struct NumaNode {
+  int id = 0;
+  std::vector<int> cpu_ids;
+};
+
+std::vector<NumaNode> get_numa_nodes();
+bool pin_current_thread(const std::vector<int>& cpu_ids);
+bool prefer_numa_node_memory(int numa_node_id);
+
+}  // namespace uni_course_cpp
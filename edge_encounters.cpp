@@ -0,0 +1,64 @@
+#include "edge_encounters.hpp"
+#include <random>
+
+namespace {
+
+static constexpr float kGreyEdgeEncounterProbability = 0.2f;
+static constexpr float kYellowEdgeEncounterProbability = 0.3f;
+static constexpr float kRedEdgeEncounterProbability = 0.5f;
+
+uni_course_cpp::EnemyType get_random_enemy_type(std::mt19937& gen) {
+  std::uniform_int_distribution<int> distribution(
+      0, uni_course_cpp::kAllEnemyTypes.size() - 1);
+  return uni_course_cpp::kAllEnemyTypes[distribution(gen)];
+}
+
+}  // namespace
+
+namespace uni_course_cpp {
+
+float get_encounter_probability(EdgeColor color) {
+  switch (color) {
+    case EdgeColor::Grey:
+      return kGreyEdgeEncounterProbability;
+    case EdgeColor::Green:
+      return 0.0f;
+    case EdgeColor::Yellow:
+      return kYellowEdgeEncounterProbability;
+    case EdgeColor::Red:
+      return kRedEdgeEncounterProbability;
+  }
+}
+
+EdgeEncounters generate_edge_encounters(const IGraph& graph) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  EdgeEncounters edge_encounters;
+  graph.for_each_edge([&edge_encounters, &gen](const IEdge& edge) {
+    if (get_encounter_probability(edge.color()) > 0) {
+      edge_encounters.emplace(edge.id(), get_random_enemy_type(gen));
+    }
+  });
+  return edge_encounters;
+}
+
+EdgeRisks calculate_edge_risks(const EdgeEncounters& edge_encounters,
+                               const IGraph& graph,
+                               const BattleTable& battle_table) {
+  EdgeRisks edge_risks;
+  graph.for_each_edge(
+      [&edge_risks, &edge_encounters, &battle_table](const IEdge& edge) {
+        const auto encounter_it = edge_encounters.find(edge.id());
+        if (encounter_it == edge_encounters.cend())
+          return;
+        EdgeRisk edge_risk;
+        edge_risk.enemy_type = encounter_it->second;
+        edge_risk.encounter_probability =
+            get_encounter_probability(edge.color());
+        edge_risk.battle_outcome = battle_table.at(encounter_it->second);
+        edge_risks.emplace(edge.id(), edge_risk);
+      });
+  return edge_risks;
+}
+
+}  // namespace uni_course_cpp
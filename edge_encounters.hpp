@@ -0,0 +1,33 @@
+#pragma once
+
+#include <unordered_map>
+#include "battle_simulator.hpp"
+#include "interfaces/i_graph.hpp"
+
+namespace uni_course_cpp {
+
+struct EdgeRisk {
+  EnemyType enemy_type = EnemyType::Dragon;
+  float encounter_probability = 0;
+  BattleOutcome battle_outcome;
+
+  float death_probability() const {
+    return encounter_probability * (1.0f - battle_outcome.win_probability);
+  }
+  float expected_damage() const {
+    return encounter_probability * battle_outcome.expected_damage;
+  }
+};
+
+using EdgeEncounters = std::unordered_map<EdgeId, EnemyType>;
+using EdgeRisks = std::unordered_map<EdgeId, EdgeRisk>;
+
+float get_encounter_probability(EdgeColor color);
+
+EdgeEncounters generate_edge_encounters(const IGraph& graph);
+
+EdgeRisks calculate_edge_risks(const EdgeEncounters& edge_encounters,
+                               const IGraph& graph,
+                               const BattleTable& battle_table);
+
+}  // namespace uni_course_cpp
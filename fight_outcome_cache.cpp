@@ -0,0 +1,66 @@
+#include "fight_outcome_cache.hpp"
+#include <functional>
+
+namespace {
+
+void combine_hash(size_t& seed, size_t value) {
+  seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+}
+
+}  // namespace
+
+namespace uni_course_cpp {
+
+size_t FightOutcomeCache::KeyHash::operator()(const Key& key) const {
+  size_t seed = std::hash<int>()(static_cast<int>(key.enemy_type));
+  combine_hash(seed, std::hash<float>()(key.knight_stats.health()));
+  combine_hash(seed, std::hash<float>()(key.knight_stats.stamina()));
+  combine_hash(seed, std::hash<float>()(key.knight_stats.attack()));
+  return seed;
+}
+
+BattleOutcome FightOutcomeCache::get_or_simulate(
+    const FighterStats& knight_stats,
+    EnemyType enemy_type,
+    const BattleSimulator& battle_simulator) {
+  const auto key = Key{knight_stats, enemy_type};
+  auto outcome_promise = std::promise<BattleOutcome>();
+  auto outcome_future = std::shared_future<BattleOutcome>();
+  {
+    const std::lock_guard lock(mutex_);
+    const auto [outcome_it, is_inserted] = outcomes_.try_emplace(key);
+    if (!is_inserted) {
+      ++hits_count_;
+      outcome_future = outcome_it->second;
+    } else {
+      ++misses_count_;
+      outcome_it->second = outcome_promise.get_future().share();
+    }
+  }
+  if (outcome_future.valid())
+    return outcome_future.get();
+
+  try {
+    const auto outcome = battle_simulator.simulate(knight_stats, enemy_type);
+    outcome_promise.set_value(outcome);
+    return outcome;
+  } catch (...) {
+    outcome_promise.set_exception(std::current_exception());
+    const std::lock_guard lock(mutex_);
+    outcomes_.erase(key);
+    throw;
+  }
+}
+
+BattleTable FightOutcomeCache::get_or_simulate_all(
+    const FighterStats& knight_stats,
+    const BattleSimulator& battle_simulator) {
+  BattleTable battle_table;
+  for (const auto enemy_type : kAllEnemyTypes) {
+    battle_table[enemy_type] =
+        get_or_simulate(knight_stats, enemy_type, battle_simulator);
+  }
+  return battle_table;
+}
+
+}  // namespace uni_course_cpp
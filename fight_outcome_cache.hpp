@@ -0,0 +1,43 @@
+#pragma once
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+#include "battle_simulator.hpp"
+
+namespace uni_course_cpp {
+
+class FightOutcomeCache {
+ public:
+  BattleOutcome get_or_simulate(const FighterStats& knight_stats,
+                                EnemyType enemy_type,
+                                const BattleSimulator& battle_simulator);
+  BattleTable get_or_simulate_all(const FighterStats& knight_stats,
+                                  const BattleSimulator& battle_simulator);
+
+  int hits_count() const { return hits_count_; }
+  int misses_count() const { return misses_count_; }
+
+ private:
+  struct Key {
+    FighterStats knight_stats;
+    EnemyType enemy_type;
+
+    bool operator==(const Key& other) const {
+      return knight_stats == other.knight_stats &&
+             enemy_type == other.enemy_type;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  std::unordered_map<Key, std::shared_future<BattleOutcome>, KeyHash> outcomes_;
+  std::mutex mutex_;
+  std::atomic<int> hits_count_ = 0;
+  std::atomic<int> misses_count_ = 0;
+};
+
+}  // namespace uni_course_cpp
@@ -0,0 +1,43 @@
+#include "fighter.hpp"
+#include <sstream>
+
+namespace uni_course_cpp {
+
+FighterStats get_default_knight_stats() {
+  return FighterStats(100.0f, 10.0f, 15.0f);
+}
+
+FighterStats get_enemy_stats(EnemyType enemy_type) {
+  switch (enemy_type) {
+    case EnemyType::Dragon:
+      return FighterStats(120.0f, 8.0f, 18.0f);
+    case EnemyType::Wyvern:
+      return FighterStats(70.0f, 12.0f, 12.0f);
+    case EnemyType::Troll:
+      return FighterStats(90.0f, 6.0f, 14.0f);
+  }
+}
+
+namespace printing {
+
+std::string print_enemy_type(EnemyType enemy_type) {
+  switch (enemy_type) {
+    case EnemyType::Dragon:
+      return "dragon";
+    case EnemyType::Wyvern:
+      return "wyvern";
+    case EnemyType::Troll:
+      return "troll";
+  }
+}
+
+std::string print_fighter_stats(const FighterStats& stats) {
+  std::ostringstream stats_print_stream;
+  stats_print_stream << "{health: " << stats.health()
+                     << ", stamina: " << stats.stamina()
+                     << ", attack: " << stats.attack() << "}";
+  return stats_print_stream.str();
+}
+
+}  // namespace printing
+}  // namespace uni_course_cpp
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <array>
+#include <string>
+
+namespace uni_course_cpp {
+
+enum class EnemyType { Dragon, Wyvern, Troll };
+
+constexpr std::array<EnemyType, 3> kAllEnemyTypes = {
+    EnemyType::Dragon, EnemyType::Wyvern, EnemyType::Troll};
+
+struct FighterStats {
+ public:
+  FighterStats(float health, float stamina, float attack)
+      : health_(health), stamina_(stamina), attack_(attack) {}
+  float health() const { return health_; }
+  float stamina() const { return stamina_; }
+  float attack() const { return attack_; }
+
+  bool operator==(const FighterStats& other) const {
+    return health_ == other.health_ && stamina_ == other.stamina_ &&
+           attack_ == other.attack_;
+  }
+
+ private:
+  float health_ = 0;
+  float stamina_ = 0;
+  float attack_ = 0;
+};
+
+FighterStats get_default_knight_stats();
+FighterStats get_enemy_stats(EnemyType enemy_type);
+
+namespace printing {
+std::string print_enemy_type(EnemyType enemy_type);
+std::string print_fighter_stats(const FighterStats& stats);
+}  // namespace printing
+
+}  // namespace uni_course_cpp
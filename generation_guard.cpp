@@ -0,0 +1,76 @@
+#include "generation_guard.hpp"
+#include <sstream>
+
+namespace uni_course_cpp {
+
+GenerationGuard::GenerationGuard(const GenerationBudget& budget,
+                                 const CancellationToken* cancellation_token)
+    : budget_(budget), cancellation_token_(cancellation_token) {
+  if (budget_.time_limit) {
+    deadline_ = std::chrono::steady_clock::now() + *budget_.time_limit;
+  }
+}
+
+void GenerationGuard::stop(StopReason stop_reason) const {
+  auto expected_stop_reason = StopReason::None;
+  stop_reason_.compare_exchange_strong(expected_stop_reason, stop_reason);
+}
+
+bool GenerationGuard::should_stop() const {
+  if (stop_reason_ != StopReason::None)
+    return true;
+  if (cancellation_token_ && cancellation_token_->is_cancelled()) {
+    stop(StopReason::Cancelled);
+    return true;
+  }
+  if (deadline_ && std::chrono::steady_clock::now() >= *deadline_) {
+    stop(StopReason::TimeLimit);
+    return true;
+  }
+  return false;
+}
+
+bool GenerationGuard::should_stop(long long vertices_count,
+                                  long long edges_count) const {
+  if (should_stop())
+    return true;
+  if (budget_.max_vertices_count &&
+      vertices_count > *budget_.max_vertices_count) {
+    stop(StopReason::VerticesLimit);
+    return true;
+  }
+  if (budget_.max_edges_count && edges_count > *budget_.max_edges_count) {
+    stop(StopReason::EdgesLimit);
+    return true;
+  }
+  return false;
+}
+
+void GenerationGuard::throw_if_stopped(long long vertices_count,
+                                       long long edges_count) const {
+  if (!should_stop(vertices_count, edges_count))
+    return;
+
+  std::ostringstream message;
+  switch (stop_reason_.load()) {
+    case StopReason::None:
+      return;
+    case StopReason::Cancelled:
+      message << "Generation cancelled";
+      break;
+    case StopReason::TimeLimit:
+      message << "Generation time limit exceeded";
+      break;
+    case StopReason::VerticesLimit:
+      message << "Generation vertices limit exceeded";
+      break;
+    case StopReason::EdgesLimit:
+      message << "Generation edges limit exceeded";
+      break;
+  }
+  message << " (partial graph: " << vertices_count << " vertices, "
+          << edges_count << " edges)";
+  throw GenerationCancelledError(message.str());
+}
+
+}  // namespace uni_course_cpp
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include "interfaces/i_graph.hpp"
+
+namespace uni_course_cpp {
+
+class CancellationToken {
+ public:
+  void cancel() { is_cancelled_ = true; }
+  bool is_cancelled() const { return is_cancelled_; }
+
+ private:
+  std::atomic<bool> is_cancelled_ = false;
+};
+
+struct GenerationBudget {
+  std::optional<std::chrono::milliseconds> time_limit;
+  std::optional<int> max_vertices_count;
+  std::optional<int> max_edges_count;
+};
+
+class GenerationCancelledError : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+class GenerationGuard {
+ public:
+  GenerationGuard() = default;
+  GenerationGuard(const GenerationBudget& budget,
+                  const CancellationToken* cancellation_token);
+
+  bool should_stop() const;
+  bool should_stop(long long vertices_count, long long edges_count) const;
+  bool should_stop(const IGraph& graph) const {
+    return should_stop(graph.vertices_count(), graph.edges_count());
+  }
+  void throw_if_stopped(long long vertices_count,
+                        long long edges_count) const;
+  void throw_if_stopped(const IGraph& graph) const {
+    throw_if_stopped(graph.vertices_count(), graph.edges_count());
+  }
+
+ private:
+  enum class StopReason {
+    None,
+    Cancelled,
+    TimeLimit,
+    VerticesLimit,
+    EdgesLimit
+  };
+
+  void stop(StopReason stop_reason) const;
+
+  GenerationBudget budget_;
+  const CancellationToken* cancellation_token_ = nullptr;
+  std::optional<std::chrono::steady_clock::time_point> deadline_;
+  mutable std::atomic<StopReason> stop_reason_ = StopReason::None;
+};
+
+}  // namespace uni_course_cpp
@@ -1,9 +1,102 @@
 #include "graph.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
 namespace uni_course_cpp {
 
 static constexpr GraphDepth kDefaultDepth = 1;
 
+namespace {
+
+size_t get_node_size(size_t value_size) {
+  constexpr size_t kAlignment = alignof(std::max_align_t);
+  const size_t node_size = sizeof(void*) + value_size;
+  return (node_size + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+template <typename Container>
+size_t get_hash_container_memory_usage(const Container& container) {
+  return container.bucket_count() * sizeof(void*) +
+         container.size() *
+             get_node_size(sizeof(typename Container::value_type));
+}
+
+template <typename Container>
+size_t get_vector_memory_usage(const Container& container) {
+  return container.capacity() * sizeof(typename Container::value_type);
+}
+
+class EdgeBatchColorClassifier {
+ public:
+  explicit EdgeBatchColorClassifier(const Graph& graph) : graph_(graph) {}
+
+  EdgeColor classify(VertexId from_vertex_id, VertexId to_vertex_id) {
+    const auto color = calculate_edge_color(from_vertex_id, to_vertex_id);
+    batch_connected_vertex_ids_.insert(from_vertex_id);
+    batch_connected_vertex_ids_.insert(to_vertex_id);
+    batch_connected_pairs_.insert(get_pair_key(from_vertex_id, to_vertex_id));
+    if (color == EdgeColor::Grey) {
+      batch_vertex_depths_[to_vertex_id] = get_vertex_depth(from_vertex_id) + 1;
+    }
+    return color;
+  }
+
+ private:
+  static uint64_t get_pair_key(VertexId first_vertex_id,
+                               VertexId second_vertex_id) {
+    const auto [min_vertex_id, max_vertex_id] =
+        std::minmax(first_vertex_id, second_vertex_id);
+    return (static_cast<uint64_t>(static_cast<uint32_t>(min_vertex_id)) << 32) |
+           static_cast<uint32_t>(max_vertex_id);
+  }
+
+  GraphDepth get_vertex_depth(VertexId id) const {
+    const auto depth_it = batch_vertex_depths_.find(id);
+    return depth_it != batch_vertex_depths_.cend()
+               ? depth_it->second
+               : graph_.get_vertex_depth(id);
+  }
+
+  bool has_edges(VertexId id) const {
+    return !graph_.get_connected_edge_ids(id).empty() ||
+           batch_connected_vertex_ids_.count(id);
+  }
+
+  bool are_connected(VertexId from_vertex_id, VertexId to_vertex_id) const {
+    return batch_connected_pairs_.count(
+               get_pair_key(from_vertex_id, to_vertex_id)) ||
+           graph_.are_connected(from_vertex_id, to_vertex_id);
+  }
+
+  EdgeColor calculate_edge_color(VertexId from_vertex_id,
+                                 VertexId to_vertex_id) const {
+    const auto from_vertex_depth = get_vertex_depth(from_vertex_id);
+    const auto to_vertex_depth = get_vertex_depth(to_vertex_id);
+    if (from_vertex_id == to_vertex_id) {
+      return EdgeColor::Green;
+    }
+    if (!has_edges(to_vertex_id)) {
+      return EdgeColor::Grey;
+    }
+    if (to_vertex_depth - from_vertex_depth == 1 &&
+        !are_connected(from_vertex_id, to_vertex_id)) {
+      return EdgeColor::Yellow;
+    }
+    if (to_vertex_depth - from_vertex_depth == 2) {
+      return EdgeColor::Red;
+    }
+    throw std::runtime_error("Failed to determine color");
+  }
+
+  const Graph& graph_;
+  std::unordered_set<VertexId> batch_connected_vertex_ids_;
+  std::unordered_set<uint64_t> batch_connected_pairs_;
+  std::unordered_map<VertexId, GraphDepth> batch_vertex_depths_;
+};
+
+}  // namespace
+
 EdgeColor Graph::calculate_edge_color(VertexId from_vertex_id,
                                       VertexId to_vertex_id) const {
   const auto from_vertex_depth = get_vertex_depth(from_vertex_id);
@@ -36,6 +129,116 @@ void Graph::for_each_edge(
                 [&handler](const auto& element) { handler(element); });
 }
 
+GraphMemoryUsage Graph::memory_usage() const {
+  GraphMemoryUsage usage;
+  usage.edges_bytes = get_vector_memory_usage(edges_);
+  usage.vertices_bytes = get_vector_memory_usage(vertices_);
+  usage.adjacency_list_bytes = get_hash_container_memory_usage(adjacency_list_);
+  for (const auto& [vertex_id, edge_ids] : adjacency_list_) {
+    usage.adjacency_list_bytes += get_hash_container_memory_usage(edge_ids);
+  }
+  usage.depth_vertex_ids_bytes =
+      get_hash_container_memory_usage(depth_vertex_ids_);
+  for (const auto& [depth, vertex_ids] : depth_vertex_ids_) {
+    usage.depth_vertex_ids_bytes += get_hash_container_memory_usage(vertex_ids);
+  }
+  usage.depth_vertex_ids_bytes +=
+      get_vector_memory_usage(depth_vertex_ranges_);
+  usage.vertex_depths_bytes = get_hash_container_memory_usage(vertex_depths_);
+  return usage;
+}
+
+std::optional<VertexRange> Graph::get_depth_vertex_range(
+    GraphDepth depth) const {
+  if (depth < kDefaultDepth ||
+      depth >= static_cast<GraphDepth>(depth_vertex_ranges_.size()))
+    return std::nullopt;
+  return depth_vertex_ranges_[depth];
+}
+
+void Graph::renumber_vertices_by_depth() {
+  auto vertex_ids_order = std::vector<VertexId>();
+  vertex_ids_order.reserve(vertices_.size());
+  auto new_vertex_ids = std::unordered_map<VertexId, VertexId>();
+  new_vertex_ids.reserve(vertices_.size());
+  auto new_depth_vertex_ranges =
+      std::vector<VertexRange>(depth() + kDefaultDepth);
+
+  for (GraphDepth depth = kDefaultDepth; depth <= this->depth(); ++depth) {
+    const VertexId layer_begin = vertex_ids_order.size();
+    const VertexId parents_begin = new_depth_vertex_ranges[depth - 1].begin;
+    for (VertexId parent_index = parents_begin; parent_index < layer_begin;
+         ++parent_index) {
+      const auto parent_vertex_id = vertex_ids_order[parent_index];
+      auto child_vertex_ids = std::vector<VertexId>();
+      for (const auto edge_id : get_connected_edge_ids(parent_vertex_id)) {
+        const auto& edge = edges_[edge_id];
+        if (edge.color() == EdgeColor::Grey &&
+            edge.from_vertex_id() == parent_vertex_id) {
+          child_vertex_ids.push_back(edge.to_vertex_id());
+        }
+      }
+      std::sort(child_vertex_ids.begin(), child_vertex_ids.end());
+      for (const auto child_vertex_id : child_vertex_ids) {
+        if (new_vertex_ids.emplace(child_vertex_id, vertex_ids_order.size())
+                .second) {
+          vertex_ids_order.push_back(child_vertex_id);
+        }
+      }
+    }
+
+    auto unreached_vertex_ids = std::vector<VertexId>();
+    for (const auto vertex_id : get_depth_vertex_ids(depth)) {
+      if (new_vertex_ids.find(vertex_id) == new_vertex_ids.cend()) {
+        unreached_vertex_ids.push_back(vertex_id);
+      }
+    }
+    std::sort(unreached_vertex_ids.begin(), unreached_vertex_ids.end());
+    for (const auto vertex_id : unreached_vertex_ids) {
+      new_vertex_ids.emplace(vertex_id, vertex_ids_order.size());
+      vertex_ids_order.push_back(vertex_id);
+    }
+    const VertexId layer_end = vertex_ids_order.size();
+    new_depth_vertex_ranges[depth] = VertexRange{layer_begin, layer_end};
+  }
+
+  auto new_vertices = std::vector<Vertex>();
+  new_vertices.reserve(vertex_ids_order.size());
+  auto new_adjacency_list =
+      std::unordered_map<VertexId, std::unordered_set<EdgeId>>();
+  new_adjacency_list.reserve(vertex_ids_order.size());
+  auto new_depth_vertex_ids =
+      std::unordered_map<GraphDepth, std::unordered_set<VertexId>>();
+  auto new_vertex_depths = std::unordered_map<VertexId, GraphDepth>();
+  new_vertex_depths.reserve(vertex_ids_order.size());
+  for (VertexId new_vertex_id = 0;
+       new_vertex_id < static_cast<VertexId>(vertex_ids_order.size());
+       ++new_vertex_id) {
+    const auto old_vertex_id = vertex_ids_order[new_vertex_id];
+    const auto depth = get_vertex_depth(old_vertex_id);
+    new_vertices.emplace_back(new_vertex_id);
+    new_adjacency_list.emplace(new_vertex_id,
+                               std::move(adjacency_list_.at(old_vertex_id)));
+    new_depth_vertex_ids[depth].emplace(new_vertex_id);
+    new_vertex_depths.emplace(new_vertex_id, depth);
+  }
+
+  auto new_edges = std::vector<Edge>();
+  new_edges.reserve(edges_.size());
+  for (const auto& edge : edges_) {
+    new_edges.emplace_back(edge.id(), new_vertex_ids.at(edge.from_vertex_id()),
+                           new_vertex_ids.at(edge.to_vertex_id()),
+                           edge.color());
+  }
+
+  edges_ = std::move(new_edges);
+  vertices_ = std::move(new_vertices);
+  adjacency_list_ = std::move(new_adjacency_list);
+  depth_vertex_ids_ = std::move(new_depth_vertex_ids);
+  vertex_depths_ = std::move(new_vertex_depths);
+  depth_vertex_ranges_ = std::move(new_depth_vertex_ranges);
+}
+
 bool Graph::are_connected(VertexId from_vertex_id,
                           VertexId to_vertex_id) const {
   if (from_vertex_id == to_vertex_id) {
@@ -57,6 +260,7 @@ bool Graph::are_connected(VertexId from_vertex_id,
 }
 
 void Graph::set_vertex_depth(VertexId id, GraphDepth depth) {
+  depth_vertex_ranges_.clear();
   depth_vertex_ids_[depth].emplace(id);
   depth_vertex_ids_[kDefaultDepth].erase(id);
   vertex_depths_[id] = depth;
@@ -64,6 +268,7 @@ void Graph::set_vertex_depth(VertexId id, GraphDepth depth) {
 
 VertexId Graph::add_vertex() {
   const VertexId new_vertex_id = get_new_vertex_id();
+  depth_vertex_ranges_.clear();
   depth_vertex_ids_[kDefaultDepth].emplace(new_vertex_id);
   vertex_depths_[new_vertex_id] = kDefaultDepth;
   vertices_.emplace_back(new_vertex_id);
@@ -86,4 +291,50 @@ EdgeId Graph::add_edge(VertexId from_vertex_id, VertexId to_vertex_id) {
   return new_edge_id;
 }
 
+std::vector<EdgeId> Graph::add_edges(
+    const std::vector<EdgeEndpoints>& endpoints) {
+  auto color_classifier = EdgeBatchColorClassifier(*this);
+  auto colors = std::vector<EdgeColor>();
+  colors.reserve(endpoints.size());
+  for (const auto& [from_vertex_id, to_vertex_id] : endpoints) {
+    colors.push_back(color_classifier.classify(from_vertex_id, to_vertex_id));
+  }
+
+  auto new_edge_ids = std::vector<EdgeId>();
+  new_edge_ids.reserve(endpoints.size());
+  auto adjacency_updates = std::vector<std::pair<VertexId, EdgeId>>();
+  adjacency_updates.reserve(2 * endpoints.size());
+  edges_.reserve(edges_.size() + endpoints.size());
+  for (size_t i = 0; i < endpoints.size(); ++i) {
+    const auto [from_vertex_id, to_vertex_id] = endpoints[i];
+    const EdgeId new_edge_id = get_new_edge_id();
+    edges_.emplace_back(new_edge_id, from_vertex_id, to_vertex_id, colors[i]);
+    if (colors[i] == EdgeColor::Grey) {
+      set_vertex_depth(to_vertex_id, get_vertex_depth(from_vertex_id) + 1);
+    }
+    adjacency_updates.emplace_back(from_vertex_id, new_edge_id);
+    if (from_vertex_id != to_vertex_id) {
+      adjacency_updates.emplace_back(to_vertex_id, new_edge_id);
+    }
+    new_edge_ids.push_back(new_edge_id);
+  }
+
+  std::sort(adjacency_updates.begin(), adjacency_updates.end());
+  for (auto group_begin = adjacency_updates.cbegin();
+       group_begin != adjacency_updates.cend();) {
+    const auto vertex_id = group_begin->first;
+    const auto group_end = std::find_if(
+        group_begin, adjacency_updates.cend(),
+        [vertex_id](const auto& update) { return update.first != vertex_id; });
+    auto& edge_ids = adjacency_list_[vertex_id];
+    edge_ids.reserve(edge_ids.size() + (group_end - group_begin));
+    for (auto it = group_begin; it != group_end; ++it) {
+      edge_ids.emplace(it->second);
+    }
+    group_begin = group_end;
+  }
+
+  return new_edge_ids;
+}
+
 }  // namespace uni_course_cpp
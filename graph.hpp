@@ -2,14 +2,18 @@
 
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 #include "interfaces/i_graph.hpp"
 namespace uni_course_cpp {
 
 class Graph : public IGraph {
  public:
+  using EdgeEndpoints = std::pair<VertexId, VertexId>;
+
   VertexId add_vertex() override;
   EdgeId add_edge(VertexId from_vertex_id, VertexId to_vertex_id) override;
+  std::vector<EdgeId> add_edges(const std::vector<EdgeEndpoints>& endpoints);
   bool are_connected(VertexId from_vertex_id,
                      VertexId to_vertex_id) const override;
   GraphDepth get_vertex_depth(VertexId id) const override {
@@ -30,6 +34,11 @@ class Graph : public IGraph {
       GraphDepth depth) const override {
     return depth_vertex_ids_.at(depth);
   }
+  std::optional<VertexRange> get_depth_vertex_range(
+      GraphDepth depth) const override;
+  GraphMemoryUsage memory_usage() const override;
+
+  void renumber_vertices_by_depth();
 
  private:
   struct Vertex : IVertex {
@@ -76,5 +85,6 @@ class Graph : public IGraph {
   std::unordered_map<GraphDepth, std::unordered_set<VertexId>>
       depth_vertex_ids_;
   std::unordered_map<VertexId, GraphDepth> vertex_depths_;
+  std::vector<VertexRange> depth_vertex_ranges_;
 };
 }  // namespace uni_course_cpp
@@ -0,0 +1,126 @@
+#include "graph_compression.hpp"
+#include <zlib.h>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include "parallel_for.hpp"
+
+namespace {
+
+static constexpr size_t kBlockSize = 1 << 20;
+static constexpr size_t kStreamChunkSize = 1 << 16;
+static constexpr int kCompressionLevel = Z_DEFAULT_COMPRESSION;
+static constexpr int kGzipWindowBits = 15 + 16;
+static constexpr int kAutoDetectWindowBits = 15 + 32;
+static constexpr int kMemoryLevel = 8;
+
+std::string compress_block(const char* data, size_t size) {
+  z_stream stream = {};
+  if (deflateInit2(&stream, kCompressionLevel, Z_DEFLATED, kGzipWindowBits,
+                   kMemoryLevel, Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw std::runtime_error("Failed to initialize compression");
+  }
+
+  std::string compressed_block(deflateBound(&stream, size), '\0');
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+  stream.avail_in = size;
+  stream.next_out = reinterpret_cast<Bytef*>(compressed_block.data());
+  stream.avail_out = compressed_block.size();
+  const int result = deflate(&stream, Z_FINISH);
+  compressed_block.resize(stream.total_out);
+  deflateEnd(&stream);
+  if (result != Z_STREAM_END) {
+    throw std::runtime_error("Failed to compress block");
+  }
+  return compressed_block;
+}
+
+}  // namespace
+
+namespace uni_course_cpp {
+namespace compression {
+
+std::string compress(const std::string& data, int threads_count) {
+  const int blocks_count =
+      std::max<size_t>(1, (data.size() + kBlockSize - 1) / kBlockSize);
+  auto compressed_blocks = std::vector<std::string>(blocks_count);
+  parallel_for(0, blocks_count, threads_count,
+               [&data, &compressed_blocks](int, int block_begin,
+                                           int block_end) {
+                 for (int i = block_begin; i < block_end; ++i) {
+                   const size_t offset = i * kBlockSize;
+                   compressed_blocks[i] = compress_block(
+                       data.data() + offset,
+                       std::min(kBlockSize, data.size() - offset));
+                 }
+               });
+
+  size_t compressed_size = 0;
+  for (const auto& compressed_block : compressed_blocks) {
+    compressed_size += compressed_block.size();
+  }
+  std::string compressed_data;
+  compressed_data.reserve(compressed_size);
+  for (const auto& compressed_block : compressed_blocks) {
+    compressed_data += compressed_block;
+  }
+  return compressed_data;
+}
+
+void decompress_stream(std::istream& input, const ChunkHandler& chunk_handler) {
+  z_stream stream = {};
+  if (inflateInit2(&stream, kAutoDetectWindowBits) != Z_OK) {
+    throw std::runtime_error("Failed to initialize decompression");
+  }
+
+  auto input_chunk = std::vector<char>(kStreamChunkSize);
+  auto output_chunk = std::vector<char>(kStreamChunkSize);
+  bool is_member_finished = true;
+  while (input) {
+    input.read(input_chunk.data(), input_chunk.size());
+    stream.next_in = reinterpret_cast<Bytef*>(input_chunk.data());
+    stream.avail_in = input.gcount();
+
+    while (stream.avail_in > 0) {
+      is_member_finished = false;
+      stream.next_out = reinterpret_cast<Bytef*>(output_chunk.data());
+      stream.avail_out = output_chunk.size();
+      const int result = inflate(&stream, Z_NO_FLUSH);
+      if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+        inflateEnd(&stream);
+        throw std::runtime_error("Failed to decompress stream");
+      }
+      const size_t output_size = output_chunk.size() - stream.avail_out;
+      if (output_size > 0) {
+        chunk_handler(output_chunk.data(), output_size);
+      }
+      if (result == Z_STREAM_END) {
+        is_member_finished = true;
+        inflateReset(&stream);
+      } else if (result == Z_BUF_ERROR && output_size == 0) {
+        break;
+      }
+    }
+  }
+
+  inflateEnd(&stream);
+  if (!is_member_finished) {
+    throw std::runtime_error("Compressed stream is truncated");
+  }
+}
+
+std::string decompress_file(const std::string& file_path) {
+  std::ifstream input_file(file_path, std::ios::binary);
+  if (!input_file) {
+    throw std::runtime_error("Failed to open " + file_path);
+  }
+  std::string data;
+  decompress_stream(input_file, [&data](const char* chunk, size_t size) {
+    data.append(chunk, size);
+  });
+  return data;
+}
+
+}  // namespace compression
+}  // namespace uni_course_cpp
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <string>
+
+namespace uni_course_cpp {
+namespace compression {
+
+using ChunkHandler = std::function<void(const char* data, size_t size)>;
+
+std::string compress(const std::string& data, int threads_count);
+
+void decompress_stream(std::istream& input, const ChunkHandler& chunk_handler);
+
+std::string decompress_file(const std::string& file_path);
+
+}  // namespace compression
+}  // namespace uni_course_cpp
@@ -1,10 +1,55 @@
 #include "graph_generation_controller.hpp"
+#include <sched.h>
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <mutex>
+#include <sstream>
+#include "logger.hpp"
+#include "metrics.hpp"
 
 namespace {
 
 static const int kMaxThreadsCount = std::thread::hardware_concurrency();
+static const int kGeneratorThreadsCount = std::max(1, kMaxThreadsCount);
+static constexpr double kMicrosecondsInSecond = 1000000.0;
+
+thread_local int worker_numa_node_index = -1;
+std::once_flag pin_failure_log_flag;
+std::once_flag memory_policy_failure_log_flag;
+
+std::string node_statistics_string(int numa_node_id,
+                                   int graphs_count,
+                                   long long vertices_count,
+                                   long long edges_count,
+                                   long long generation_time_us) {
+  const double generation_time_s =
+      generation_time_us > 0 ? generation_time_us / kMicrosecondsInSecond
+                             : 0.0;
+  std::stringstream output;
+  output << "Numa Node " << numa_node_id << ", graphs: " << graphs_count
+         << ", vertices: " << vertices_count << ", edges: " << edges_count
+         << ", generation time: " << generation_time_s << " s";
+  if (generation_time_s > 0) {
+    output << ", throughput: " << vertices_count / generation_time_s
+           << " vertices/s, " << edges_count / generation_time_s
+           << " edges/s";
+  }
+  return output.str();
+}
+
+std::string replayed_job_string(int index) {
+  std::stringstream output;
+  output << "Graph " << index << ", Replayed From Cache";
+  return output.str();
+}
+
+std::string scheduled_job_string(int index, double expected_vertices_count) {
+  std::stringstream output;
+  output << "Graph " << index << ", Scheduled, expected vertices: "
+         << static_cast<long long>(expected_vertices_count);
+  return output.str();
+}
 
 };
 
@@ -13,43 +58,205 @@ namespace uni_course_cpp {
 GraphGenerationController::GraphGenerationController(
     int threads_count,
     int graphs_count,
-    GraphGenerator::Params&& graph_generator_params)
+    GraphGenerator::Params&& graph_generator_params,
+    std::shared_ptr<GraphReplayCache> graph_replay_cache,
+    WorkerPlacement worker_placement)
+    : GraphGenerationController(
+          threads_count,
+          std::vector<GraphGenerator::Params>(graphs_count,
+                                              graph_generator_params),
+          std::move(graph_replay_cache),
+          worker_placement) {}
+
+GraphGenerationController::GraphGenerationController(
+    int threads_count,
+    std::vector<GraphGenerator::Params> graphs_generator_params,
+    std::shared_ptr<GraphReplayCache> graph_replay_cache,
+    WorkerPlacement worker_placement)
     : threads_count_(threads_count),
-      graphs_count_(graphs_count),
-      graph_generator_(std::move(graph_generator_params)) {
+      graphs_count_(graphs_generator_params.size()),
+      numa_nodes_(get_numa_nodes()),
+      node_statistics_(numa_nodes_.size()),
+      graphs_generator_params_(std::move(graphs_generator_params)),
+      graph_replay_cache_(std::move(graph_replay_cache)) {
   Worker::GetJobCallback get_job_callback =
       [&jobs_mutex_ = jobs_mutex_,
        &jobs_ = jobs_]() -> std::optional<JobCallback> {
-    const std::lock_guard lock(jobs_mutex_);
+    auto lock = std::unique_lock(jobs_mutex_, std::try_to_lock);
+    auto wait_time = std::chrono::microseconds(0);
+    if (!lock.owns_lock()) {
+      const auto start_time = std::chrono::steady_clock::now();
+      lock.lock();
+      wait_time = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start_time);
+    }
     if (jobs_.size()) {
+      Metrics::get_metrics().add(Counter::JobsMutexWaitUs, wait_time.count());
       auto job = jobs_.front();
       jobs_.pop_front();
+      Metrics::get_metrics().set(Gauge::JobQueueDepth, jobs_.size());
       return job;
     }
     return std::nullopt;
   };
 
+  auto cpus = std::vector<std::pair<int, int>>();
+  for (int node_index = 0; node_index < static_cast<int>(numa_nodes_.size());
+       ++node_index) {
+    for (const auto cpu_id : numa_nodes_[node_index].cpu_ids) {
+      cpus.emplace_back(cpu_id, node_index);
+    }
+  }
+  const bool is_multi_node = numa_nodes_.size() > 1;
+
   threads_count = std::min(kMaxThreadsCount, threads_count_);
   for (int i = 0; i < threads_count; ++i) {
-    workers_.emplace_back(get_job_callback);
+    auto cpu_ids = std::vector<int>();
+    int node_index = -1;
+    switch (worker_placement) {
+      case WorkerPlacement::Floating:
+        break;
+      case WorkerPlacement::Core:
+        cpu_ids.push_back(cpus[i % cpus.size()].first);
+        node_index = cpus[i % cpus.size()].second;
+        break;
+      case WorkerPlacement::NumaNode:
+        node_index = i % numa_nodes_.size();
+        cpu_ids = numa_nodes_[node_index].cpu_ids;
+        break;
+    }
+    const int preferred_memory_node_id =
+        is_multi_node && node_index >= 0 ? numa_nodes_[node_index].id : -1;
+    workers_.emplace_back(get_job_callback, std::move(cpu_ids), node_index,
+                          preferred_memory_node_id);
+  }
+}
+
+std::vector<GraphGenerationController::ScheduledJob>
+GraphGenerationController::schedule_jobs() const {
+  auto scheduled_jobs = std::vector<ScheduledJob>();
+  scheduled_jobs.reserve(graphs_count_);
+  for (int i = 0; i < graphs_count_; ++i) {
+    scheduled_jobs.push_back(
+        {i, graphs_generator_params_[i].expected_vertices_count()});
+  }
+
+  std::stable_sort(scheduled_jobs.begin(), scheduled_jobs.end(),
+                   [](const ScheduledJob& lhs, const ScheduledJob& rhs) {
+                     return lhs.expected_vertices_count >
+                            rhs.expected_vertices_count;
+                   });
+  return scheduled_jobs;
+}
+
+int GraphGenerationController::get_current_numa_node_index() const {
+  if (worker_numa_node_index >= 0)
+    return worker_numa_node_index;
+  const int cpu_id = sched_getcpu();
+  for (int node_index = 0; node_index < static_cast<int>(numa_nodes_.size());
+       ++node_index) {
+    const auto& cpu_ids = numa_nodes_[node_index].cpu_ids;
+    if (std::find(cpu_ids.cbegin(), cpu_ids.cend(), cpu_id) != cpu_ids.cend())
+      return node_index;
+  }
+  return 0;
+}
+
+void GraphGenerationController::log_node_statistics() const {
+  auto& logger = Logger::get_logger();
+  for (int node_index = 0; node_index < static_cast<int>(numa_nodes_.size());
+       ++node_index) {
+    const auto& statistics = node_statistics_[node_index];
+    if (statistics.graphs_count == 0)
+      continue;
+    logger.log(node_statistics_string(
+        numa_nodes_[node_index].id, statistics.graphs_count,
+        statistics.vertices_count, statistics.edges_count,
+        statistics.generation_time_us));
   }
 }
 
 void GraphGenerationController::generate(
     const GenStartedCallback& gen_started_callback,
-    const GenFinishedCallback& gen_finished_callback) {
+    const GenFinishedCallback& gen_finished_callback,
+    const GenFailedCallback& gen_failed_callback) {
   std::mutex callback_mutex;
-  std::atomic<int> active_jobs_counter = graphs_count_;
-  for (int i = 0; i < graphs_count_; ++i) {
-    jobs_.emplace_back([&graph_generator_ = graph_generator_, &callback_mutex,
-                        &gen_started_callback, &gen_finished_callback, i,
-                        &active_jobs_counter]() {
+  std::atomic<int> active_jobs_counter = 0;
+  auto& logger = Logger::get_logger();
+  for (const auto& scheduled_job : schedule_jobs()) {
+    const auto i = scheduled_job.index;
+    const auto& graph_generator_params = graphs_generator_params_[i];
+    if (graph_replay_cache_) {
+      auto cached_graph = graph_replay_cache_->load(
+          GraphReplayCache::Key(graph_generator_params, i));
+      if (cached_graph) {
+        logger.log(replayed_job_string(i));
+        gen_started_callback(i);
+        if (graph_ready_callback_) {
+          graph_ready_callback_(i, *cached_graph);
+        }
+        gen_finished_callback(i, std::move(cached_graph));
+        continue;
+      }
+    }
+
+    logger.log(scheduled_job_string(i, scheduled_job.expected_vertices_count));
+    ++active_jobs_counter;
+    jobs_.emplace_back([&graph_generator_params,
+                        &graph_replay_cache_ = graph_replay_cache_,
+                        &callback_mutex, &gen_started_callback,
+                        &gen_finished_callback, &gen_failed_callback, i,
+                        &active_jobs_counter, this]() {
+      const auto report_failure = [&callback_mutex, &gen_failed_callback, i,
+                                   &active_jobs_counter](
+                                      const std::string& error) {
+        Metrics::get_metrics().add(Counter::GraphsCancelled, 1);
+        if (gen_failed_callback) {
+          const std::lock_guard lock(callback_mutex);
+          gen_failed_callback(i, error);
+        }
+        --active_jobs_counter;
+      };
+      if (cancellation_token_.is_cancelled()) {
+        report_failure("Generation cancelled before start");
+        return;
+      }
+
       {
         const std::lock_guard lock(callback_mutex);
         gen_started_callback(i);
       }
 
-      auto graph = graph_generator_.generate();
+      const auto start_time = std::chrono::steady_clock::now();
+      auto graph = std::unique_ptr<IGraph>();
+      try {
+        const auto graph_generator =
+            GraphGenerator(GraphGenerator::Params(graph_generator_params));
+        graph = graph_generator.generate(
+            GenerationGuard(job_budget_, &cancellation_token_),
+            kGeneratorThreadsCount);
+      } catch (const GenerationCancelledError& error) {
+        report_failure(error.what());
+        return;
+      }
+      const auto generation_time =
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - start_time);
+      auto& statistics = node_statistics_[get_current_numa_node_index()];
+      ++statistics.graphs_count;
+      statistics.vertices_count += graph->vertices_count();
+      statistics.edges_count += graph->edges_count();
+      statistics.generation_time_us += generation_time.count();
+
+      auto& metrics = Metrics::get_metrics();
+      metrics.add(Counter::GraphsCompleted, 1);
+      if (graph_replay_cache_) {
+        graph_replay_cache_->store(
+            GraphReplayCache::Key(graph_generator_params, i), *graph);
+      }
+      if (graph_ready_callback_) {
+        graph_ready_callback_(i, *graph);
+      }
 
       {
         const std::lock_guard lock(callback_mutex);
@@ -59,6 +266,7 @@ void GraphGenerationController::generate(
     });
   }
 
+  Metrics::get_metrics().set(Gauge::JobQueueDepth, jobs_.size());
   for (auto& worker : workers_) {
     worker.start();
   }
@@ -69,6 +277,8 @@ void GraphGenerationController::generate(
   for (auto& worker : workers_) {
     worker.stop();
   }
+
+  log_node_statistics();
 }
 
 void GraphGenerationController::Worker::start() {
@@ -77,20 +287,47 @@ void GraphGenerationController::Worker::start() {
 
   state_ = State::Working;
 
-  thread_ =
-      std::thread([&state_ = state_, &get_job_callback_ = get_job_callback_]() {
-        while (true) {
-          if (state_ == State::ShouldTerminate) {
-            return;
-          }
-
-          const auto job_optional = get_job_callback_();
-          if (job_optional.has_value()) {
-            const auto& job = job_optional.value();
-            job();
-          }
-        }
+  thread_ = std::thread([&state_ = state_,
+                         &get_job_callback_ = get_job_callback_,
+                         &cpu_ids_ = cpu_ids_,
+                         numa_node_index = numa_node_index_,
+                         preferred_memory_node_id =
+                             preferred_memory_node_id_]() {
+    if (!cpu_ids_.empty() && !pin_current_thread(cpu_ids_)) {
+      std::call_once(pin_failure_log_flag, []() {
+        Logger::get_logger().log(
+            "Worker Placement, failed to pin worker threads, running them "
+            "unpinned");
       });
+    }
+    if (preferred_memory_node_id >= 0 &&
+        !prefer_numa_node_memory(preferred_memory_node_id)) {
+      std::call_once(memory_policy_failure_log_flag, []() {
+        Logger::get_logger().log(
+            "Worker Placement, failed to prefer numa node memory, using the "
+            "default memory policy");
+      });
+    }
+    worker_numa_node_index = numa_node_index;
+
+    auto& metrics = Metrics::get_metrics();
+    metrics.begin_activity(Counter::WorkerIdleUs);
+
+    while (true) {
+      if (state_ == State::ShouldTerminate) {
+        metrics.end_activity();
+        return;
+      }
+
+      const auto job_optional = get_job_callback_();
+      if (job_optional.has_value()) {
+        metrics.begin_activity(Counter::WorkerBusyUs);
+        const auto& job = job_optional.value();
+        job();
+        metrics.begin_activity(Counter::WorkerIdleUs);
+      }
+    }
+  });
 }
 
 void GraphGenerationController::Worker::stop() {
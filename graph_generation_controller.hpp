@@ -3,25 +3,54 @@
 #include <atomic>
 #include <functional>
 #include <list>
+#include <memory>
 #include <optional>
 #include <thread>
+#include <vector>
+#include "cpu_topology.hpp"
+#include "generation_guard.hpp"
+#include "graph_replay_cache.hpp"
 #include "graph_generator.hpp"
 #include "interfaces/i_worker.hpp"
 
 namespace uni_course_cpp {
 class GraphGenerationController {
  public:
+  enum class WorkerPlacement { Floating, Core, NumaNode };
+
   using GenStartedCallback = std::function<void(int index)>;
   using GenFinishedCallback =
       std::function<void(int index,
                          std::unique_ptr<uni_course_cpp::IGraph> graph)>;
+  using GenFailedCallback =
+      std::function<void(int index, const std::string& error)>;
+  using GraphReadyCallback =
+      std::function<void(int index, const uni_course_cpp::IGraph& graph)>;
 
-  GraphGenerationController(int threads_count,
-                            int graphs_count,
-                            GraphGenerator::Params&& graph_generator_params);
+  GraphGenerationController(
+      int threads_count,
+      int graphs_count,
+      GraphGenerator::Params&& graph_generator_params,
+      std::shared_ptr<GraphReplayCache> graph_replay_cache = nullptr,
+      WorkerPlacement worker_placement = WorkerPlacement::Floating);
+  GraphGenerationController(
+      int threads_count,
+      std::vector<GraphGenerator::Params> graphs_generator_params,
+      std::shared_ptr<GraphReplayCache> graph_replay_cache = nullptr,
+      WorkerPlacement worker_placement = WorkerPlacement::Floating);
 
   void generate(const GenStartedCallback& gen_started_callback,
-                const GenFinishedCallback& gen_finished_callback);
+                const GenFinishedCallback& gen_finished_callback,
+                const GenFailedCallback& gen_failed_callback = nullptr);
+
+  void set_job_budget(const GenerationBudget& job_budget) {
+    job_budget_ = job_budget;
+  }
+  void set_graph_ready_callback(
+      const GraphReadyCallback& graph_ready_callback) {
+    graph_ready_callback_ = graph_ready_callback;
+  }
+  void cancel() { cancellation_token_.cancel(); }
 
  private:
   using JobCallback = std::function<void()>;
@@ -30,8 +59,14 @@ class GraphGenerationController {
    public:
     using GetJobCallback = std::function<std::optional<JobCallback>()>;
 
-    explicit Worker(const GetJobCallback& get_job_callback)
-        : get_job_callback_(get_job_callback){};
+    Worker(const GetJobCallback& get_job_callback,
+           std::vector<int> cpu_ids,
+           int numa_node_index,
+           int preferred_memory_node_id)
+        : get_job_callback_(get_job_callback),
+          cpu_ids_(std::move(cpu_ids)),
+          numa_node_index_(numa_node_index),
+          preferred_memory_node_id_(preferred_memory_node_id){};
     ~Worker() override;
 
     void start() override;
@@ -42,9 +77,28 @@ class GraphGenerationController {
 
     std::thread thread_;
     GetJobCallback get_job_callback_;
+    std::vector<int> cpu_ids_;
+    int numa_node_index_ = -1;
+    int preferred_memory_node_id_ = -1;
     std::atomic<State> state_ = State::Idle;
   };
 
+  struct NodeStatistics {
+    std::atomic<int> graphs_count = 0;
+    std::atomic<long long> vertices_count = 0;
+    std::atomic<long long> edges_count = 0;
+    std::atomic<long long> generation_time_us = 0;
+  };
+
+  struct ScheduledJob {
+    int index = 0;
+    double expected_vertices_count = 0;
+  };
+
+  std::vector<ScheduledJob> schedule_jobs() const;
+  int get_current_numa_node_index() const;
+  void log_node_statistics() const;
+
   std::list<Worker> workers_;
   std::list<JobCallback> jobs_;
 
@@ -52,7 +106,15 @@ class GraphGenerationController {
   int graphs_count_;
   std::mutex jobs_mutex_;
 
-  GraphGenerator graph_generator_;
+  std::vector<NumaNode> numa_nodes_;
+  std::vector<NodeStatistics> node_statistics_;
+
+  std::vector<GraphGenerator::Params> graphs_generator_params_;
+  std::shared_ptr<GraphReplayCache> graph_replay_cache_;
+
+  GenerationBudget job_budget_;
+  GraphReadyCallback graph_ready_callback_;
+  CancellationToken cancellation_token_;
 };
 
 };  // namespace uni_course_cpp
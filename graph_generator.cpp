@@ -5,6 +5,7 @@
 #include <optional>
 #include <random>
 #include <thread>
+#include "metrics.hpp"
 
 namespace {
 
@@ -15,6 +16,7 @@ static constexpr float kRedEdgeProbability = 1.0f / 3.0f;
 static constexpr uni_course_cpp::GraphDepth kDefaultDepth = 1;
 static constexpr uni_course_cpp::GraphDepth kYellowDepthStep = 1;
 static constexpr uni_course_cpp::GraphDepth kRedDepthStep = 2;
+static constexpr int kMaxSamplingAttemptsCount = 8;
 static const int kMaxThreadsCount = std::thread::hardware_concurrency();
 
 bool check_probability(float probability) {
@@ -37,37 +39,119 @@ uni_course_cpp::VertexId get_random_vertex_id(
   return pickable_vertex_ids[random_number];
 }
 
+struct DepthLayer {
+  std::optional<uni_course_cpp::VertexRange> vertex_range;
+  std::vector<uni_course_cpp::VertexId> vertex_ids;
+
+  int size() const {
+    return vertex_range ? vertex_range->size() : vertex_ids.size();
+  }
+  uni_course_cpp::VertexId operator[](int index) const {
+    return vertex_range ? vertex_range->begin + index : vertex_ids[index];
+  }
+};
+
+uni_course_cpp::VertexId get_random_vertex_id(const DepthLayer& depth_layer) {
+  return depth_layer[random_number_in_range(depth_layer.size())];
+}
+
+using DepthVertexIndex = std::vector<DepthLayer>;
+
+DepthVertexIndex build_depth_vertex_index(const Graph& graph) {
+  auto depth_vertex_index = DepthVertexIndex(graph.depth() + kDefaultDepth);
+  for (uni_course_cpp::GraphDepth depth = kDefaultDepth; depth <= graph.depth();
+       ++depth) {
+    auto& depth_layer = depth_vertex_index[depth];
+    depth_layer.vertex_range = graph.get_depth_vertex_range(depth);
+    if (!depth_layer.vertex_range) {
+      const auto& depth_vertex_ids = graph.get_depth_vertex_ids(depth);
+      depth_layer.vertex_ids.assign(depth_vertex_ids.cbegin(),
+                                    depth_vertex_ids.cend());
+    }
+  }
+  return depth_vertex_index;
+}
+
+using GreyChildrenIndex = std::vector<std::vector<uni_course_cpp::VertexId>>;
+
+GreyChildrenIndex build_grey_children_index(const Graph& graph) {
+  auto grey_children_index = GreyChildrenIndex(graph.vertices_count());
+  graph.for_each_edge(
+      [&grey_children_index](const uni_course_cpp::IEdge& edge) {
+        if (edge.color() == uni_course_cpp::EdgeColor::Grey) {
+          grey_children_index[edge.from_vertex_id()].push_back(
+              edge.to_vertex_id());
+        }
+      });
+  return grey_children_index;
+}
+
+bool is_grey_child(
+    const std::vector<uni_course_cpp::VertexId>& grey_children_ids,
+    uni_course_cpp::VertexId vertex_id) {
+  return std::find(grey_children_ids.cbegin(), grey_children_ids.cend(),
+                   vertex_id) != grey_children_ids.cend();
+}
+
 std::vector<uni_course_cpp::VertexId> get_unconnected_vertex_ids(
-    const Graph& graph,
-    uni_course_cpp::VertexId from_vertex_id,
-    uni_course_cpp::GraphDepth depth,
-    std::mutex& colored_edges_mutex) {
-  const auto& next_depth_vertex_ids =
-      graph.get_depth_vertex_ids(depth + kYellowDepthStep);
+    const std::vector<uni_course_cpp::VertexId>& grey_children_ids,
+    const DepthLayer& next_depth_layer) {
   std::vector<uni_course_cpp::VertexId> pickable_vertex_ids;
-  for (const auto to_vertex_id : next_depth_vertex_ids) {
-    const auto are_connected = [&graph, from_vertex_id, to_vertex_id,
-                                &colored_edges_mutex]() {
-      const std::lock_guard<std::mutex> lock(colored_edges_mutex);
-      return graph.are_connected(from_vertex_id, to_vertex_id);
-    }();
-
-    if (!are_connected) {
+  for (int index = 0; index < next_depth_layer.size(); ++index) {
+    const auto to_vertex_id = next_depth_layer[index];
+    if (!is_grey_child(grey_children_ids, to_vertex_id)) {
       pickable_vertex_ids.emplace_back(to_vertex_id);
     }
   }
   return pickable_vertex_ids;
 }
 
+std::optional<uni_course_cpp::VertexId> get_random_unconnected_vertex_id(
+    const std::vector<uni_course_cpp::VertexId>& grey_children_ids,
+    const DepthLayer& next_depth_layer) {
+  if (next_depth_layer.size() == 0)
+    return std::nullopt;
+
+  for (int attempt = 0; attempt < kMaxSamplingAttemptsCount; ++attempt) {
+    const auto to_vertex_id = get_random_vertex_id(next_depth_layer);
+    if (!is_grey_child(grey_children_ids, to_vertex_id)) {
+      return to_vertex_id;
+    }
+  }
+
+  const auto pickable_vertex_ids =
+      get_unconnected_vertex_ids(grey_children_ids, next_depth_layer);
+  if (pickable_vertex_ids.empty())
+    return std::nullopt;
+  return get_random_vertex_id(pickable_vertex_ids);
+}
+
 }  // namespace
 
 namespace uni_course_cpp {
 
-void GraphGenerator::generate_grey_branch(Graph& graph,
-                                          VertexId from_vertex_id,
-                                          GraphDepth depth,
-                                          std::mutex& grey_edges_mutex) const {
-  if (depth >= params_.depth())
+double GraphGenerator::Params::expected_vertices_count() const {
+  if (depth_ <= kDefaultDepth)
+    return depth_ == kDefaultDepth ? 1.0 : 0.0;
+
+  double expected_vertices_count = 1.0;
+  double expected_depth_vertices_count = 1.0;
+  for (GraphDepth depth = kDefaultDepth; depth < depth_; ++depth) {
+    const double depth_probability =
+        (depth_ - depth) / static_cast<double>(depth_ - kDefaultDepth);
+    expected_depth_vertices_count *= new_vertices_count_ * depth_probability;
+    expected_vertices_count += expected_depth_vertices_count;
+  }
+  return expected_vertices_count;
+}
+
+void GraphGenerator::generate_grey_branch(
+    Graph& graph,
+    VertexId from_vertex_id,
+    GraphDepth depth,
+    std::mutex& grey_edges_mutex,
+    const GenerationGuard& generation_guard) const {
+  if (depth >= params_.depth() || generation_guard.should_stop())
     return;
   const float depth_probability =
       (params_.depth() - depth) /
@@ -76,20 +160,33 @@ void GraphGenerator::generate_grey_branch(Graph& graph,
   if (!check_probability(depth_probability))
     return;
 
-  const auto new_id = [&graph, &grey_edges_mutex, from_vertex_id]() {
+  const auto new_id = [&graph, &grey_edges_mutex, &generation_guard,
+                       from_vertex_id]() -> std::optional<VertexId> {
     const std::lock_guard<std::mutex> lock(grey_edges_mutex);
+    if (generation_guard.should_stop(graph))
+      return std::nullopt;
     const auto to_vertex_id = graph.add_vertex();
     graph.add_edge(from_vertex_id, to_vertex_id);
     return to_vertex_id;
   }();
+  if (!new_id)
+    return;
+  auto& metrics = Metrics::get_metrics();
+  metrics.add(Counter::VerticesGenerated, 1);
+  metrics.add(Counter::EdgesGenerated, 1);
 
   for (int i = 0; i < params_.new_vertices_count(); ++i) {
-    generate_grey_branch(graph, new_id, depth + 1, grey_edges_mutex);
+    generate_grey_branch(graph, *new_id, depth + 1, grey_edges_mutex,
+                         generation_guard);
   }
 }
 
-void GraphGenerator::generate_grey_edges(Graph& graph) const {
+void GraphGenerator::generate_grey_edges(
+    Graph& graph,
+    const GenerationGuard& generation_guard,
+    int threads_count) const {
   const VertexId root_id = graph.add_vertex();
+  Metrics::get_metrics().add(Counter::VerticesGenerated, 1);
 
   std::atomic<int> active_jobs_counter = params_.new_vertices_count();
   std::mutex grey_edges_mutex, jobs_mutex;
@@ -97,11 +194,12 @@ void GraphGenerator::generate_grey_edges(Graph& graph) const {
   auto jobs = std::list<JobCallback>();
 
   for (int i = 0; i < params_.new_vertices_count(); ++i) {
-    jobs.push_back(
-        [&graph, &grey_edges_mutex, &active_jobs_counter, root_id, this]() {
-          generate_grey_branch(graph, root_id, kDefaultDepth, grey_edges_mutex);
-          --active_jobs_counter;
-        });
+    jobs.push_back([&graph, &grey_edges_mutex, &active_jobs_counter,
+                    &generation_guard, root_id, this]() {
+      generate_grey_branch(graph, root_id, kDefaultDepth, grey_edges_mutex,
+                           generation_guard);
+      --active_jobs_counter;
+    });
   }
 
   std::atomic<bool> should_terminate = false;
@@ -129,8 +227,7 @@ void GraphGenerator::generate_grey_edges(Graph& graph) const {
     }
   };
 
-  const auto threads_count =
-      std::min(kMaxThreadsCount, params_.new_vertices_count());
+  threads_count = std::min(threads_count, params_.new_vertices_count());
 
   auto threads = std::vector<std::thread>();
   threads.reserve(threads_count);
@@ -149,86 +246,122 @@ void GraphGenerator::generate_grey_edges(Graph& graph) const {
 
 void GraphGenerator::generate_green_edges(
     Graph& graph,
-    std::mutex& colored_edges_mutex) const {
-  graph.for_each_vertex([&graph, &colored_edges_mutex](const IVertex& vertex) {
+    std::mutex& colored_edges_mutex,
+    const GenerationGuard& generation_guard) const {
+  auto green_edges = std::vector<Graph::EdgeEndpoints>();
+  graph.for_each_vertex([&green_edges](const IVertex& vertex) {
     if (check_probability(kGreenEdgeProbability)) {
-      const std::lock_guard<std::mutex> lock(colored_edges_mutex);
-      graph.add_edge(vertex.id(), vertex.id());
+      green_edges.emplace_back(vertex.id(), vertex.id());
     }
   });
+
+  const TimedLockGuard lock(colored_edges_mutex,
+                            Counter::ColoredEdgesMutexWaitUs);
+  if (generation_guard.should_stop(graph))
+    return;
+  graph.add_edges(green_edges);
+  Metrics::get_metrics().add(Counter::EdgesGenerated, green_edges.size());
 }
 
 void GraphGenerator::generate_yellow_edges(
     Graph& graph,
-    std::mutex& colored_edges_mutex) const {
+    std::mutex& colored_edges_mutex,
+    const GenerationGuard& generation_guard) const {
+  const auto depth_vertex_index = build_depth_vertex_index(graph);
+  const auto grey_children_index = [&graph, &colored_edges_mutex]() {
+    const TimedLockGuard lock(colored_edges_mutex,
+                              Counter::ColoredEdgesMutexWaitUs);
+    return build_grey_children_index(graph);
+  }();
   for (GraphDepth depth = kDefaultDepth;
        depth <= graph.depth() - kYellowDepthStep; ++depth) {
     const float depth_probability =
         (depth - kDefaultDepth) /
         static_cast<float>((graph.depth() - kYellowDepthStep - kDefaultDepth));
-    const auto& current_depth_vertex_ids = graph.get_depth_vertex_ids(depth);
-    std::for_each(
-        current_depth_vertex_ids.cbegin(), current_depth_vertex_ids.cend(),
-        [&graph, &colored_edges_mutex, depth_probability,
-         depth](auto from_vertex_id) {
-          if (check_probability(depth_probability)) {
-            std::vector<VertexId> pickable_vertex_ids =
-                get_unconnected_vertex_ids(graph, from_vertex_id, depth,
-                                           colored_edges_mutex);
-            if (!pickable_vertex_ids.empty()) {
-              const std::lock_guard<std::mutex> lock(colored_edges_mutex);
-              graph.add_edge(from_vertex_id,
-                             get_random_vertex_id(pickable_vertex_ids));
-            }
-          }
-        });
+    const auto& current_depth_layer = depth_vertex_index[depth];
+    const auto& next_depth_layer = depth_vertex_index[depth + kYellowDepthStep];
+    auto yellow_edges = std::vector<Graph::EdgeEndpoints>();
+    for (int index = 0; index < current_depth_layer.size(); ++index) {
+      if (check_probability(depth_probability)) {
+        const auto from_vertex_id = current_depth_layer[index];
+        const auto to_vertex_id = get_random_unconnected_vertex_id(
+            grey_children_index[from_vertex_id], next_depth_layer);
+        if (to_vertex_id) {
+          yellow_edges.emplace_back(from_vertex_id, *to_vertex_id);
+        }
+      }
+    }
+
+    const TimedLockGuard lock(colored_edges_mutex,
+                              Counter::ColoredEdgesMutexWaitUs);
+    if (generation_guard.should_stop(graph))
+      return;
+    graph.add_edges(yellow_edges);
+    Metrics::get_metrics().add(Counter::EdgesGenerated, yellow_edges.size());
   }
 }
 
-void GraphGenerator::generate_red_edges(Graph& graph,
-                                        std::mutex& colored_edges_mutex) const {
+void GraphGenerator::generate_red_edges(
+    Graph& graph,
+    std::mutex& colored_edges_mutex,
+    const GenerationGuard& generation_guard) const {
+  const auto depth_vertex_index = build_depth_vertex_index(graph);
   for (GraphDepth depth = kDefaultDepth; depth <= graph.depth() - kRedDepthStep;
        ++depth) {
-    const auto& next_depth_vertex_ids =
-        graph.get_depth_vertex_ids(depth + kRedDepthStep);
-    const auto& current_depth_vertex_ids = graph.get_depth_vertex_ids(depth);
-    std::for_each(
-        current_depth_vertex_ids.cbegin(), current_depth_vertex_ids.cend(),
-        [&graph, &colored_edges_mutex,
-         &next_depth_vertex_ids](auto from_vertex_id) {
-          if (check_probability(kRedEdgeProbability)) {
-            const auto random_number =
-                random_number_in_range(next_depth_vertex_ids.size());
-            const std::lock_guard<std::mutex> lock(colored_edges_mutex);
-            graph.add_edge(
-                from_vertex_id,
-                *(std::next(next_depth_vertex_ids.begin(), random_number)));
-          }
-        });
+    const auto& next_depth_layer = depth_vertex_index[depth + kRedDepthStep];
+    const auto& current_depth_layer = depth_vertex_index[depth];
+    auto red_edges = std::vector<Graph::EdgeEndpoints>();
+    for (int index = 0; index < current_depth_layer.size(); ++index) {
+      if (check_probability(kRedEdgeProbability)) {
+        red_edges.emplace_back(current_depth_layer[index],
+                               get_random_vertex_id(next_depth_layer));
+      }
+    }
+
+    const TimedLockGuard lock(colored_edges_mutex,
+                              Counter::ColoredEdgesMutexWaitUs);
+    if (generation_guard.should_stop(graph))
+      return;
+    graph.add_edges(red_edges);
+    Metrics::get_metrics().add(Counter::EdgesGenerated, red_edges.size());
   }
 }
 
 std::unique_ptr<IGraph> GraphGenerator::generate() const {
+  return generate(GenerationGuard(), kMaxThreadsCount);
+}
+
+std::unique_ptr<IGraph> GraphGenerator::generate(
+    const GenerationGuard& generation_guard,
+    int threads_count) const {
   auto graph = Graph();
   if (params_.depth() == 0)
     return std::make_unique<Graph>(std::move(graph));
 
   std::mutex colored_edges_mutex;
-  generate_grey_edges(graph);
+  generate_grey_edges(graph, generation_guard, threads_count);
+  generation_guard.throw_if_stopped(graph);
+  if (params_.renumber_vertices_by_depth()) {
+    graph.renumber_vertices_by_depth();
+  }
 
-  std::thread green_thread([&graph, &colored_edges_mutex, this]() {
-    generate_green_edges(graph, colored_edges_mutex);
-  });
-  std::thread yellow_thread([&graph, &colored_edges_mutex, this]() {
-    generate_yellow_edges(graph, colored_edges_mutex);
-  });
-  std::thread red_thread([&graph, &colored_edges_mutex, this]() {
-    generate_red_edges(graph, colored_edges_mutex);
-  });
+  std::thread green_thread(
+      [&graph, &colored_edges_mutex, &generation_guard, this]() {
+        generate_green_edges(graph, colored_edges_mutex, generation_guard);
+      });
+  std::thread yellow_thread(
+      [&graph, &colored_edges_mutex, &generation_guard, this]() {
+        generate_yellow_edges(graph, colored_edges_mutex, generation_guard);
+      });
+  std::thread red_thread(
+      [&graph, &colored_edges_mutex, &generation_guard, this]() {
+        generate_red_edges(graph, colored_edges_mutex, generation_guard);
+      });
 
   green_thread.join();
   yellow_thread.join();
   red_thread.join();
+  generation_guard.throw_if_stopped(graph);
 
   return std::make_unique<Graph>(std::move(graph));
 }
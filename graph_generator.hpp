@@ -1,37 +1,58 @@
 #pragma once
 #include <memory>
 #include <mutex>
+#include "generation_guard.hpp"
 #include "graph.hpp"
 #include "interfaces/i_graph.hpp"
 
 namespace uni_course_cpp {
 class GraphGenerator {
  public:
+  static constexpr int kVersion = 1;
+
   struct Params {
    public:
-    Params(GraphDepth depth, int new_vertices_count)
-        : depth_(depth), new_vertices_count_(new_vertices_count) {}
+    Params(GraphDepth depth,
+           int new_vertices_count,
+           bool renumber_vertices_by_depth = false)
+        : depth_(depth),
+          new_vertices_count_(new_vertices_count),
+          renumber_vertices_by_depth_(renumber_vertices_by_depth) {}
     GraphDepth depth() const { return depth_; }
     int new_vertices_count() const { return new_vertices_count_; }
+    bool renumber_vertices_by_depth() const {
+      return renumber_vertices_by_depth_;
+    }
+    double expected_vertices_count() const;
 
    private:
     GraphDepth depth_ = 0;
     int new_vertices_count_ = 0;
+    bool renumber_vertices_by_depth_ = false;
   };
 
   explicit GraphGenerator(Params&& params) : params_(std::move(params)) {}
   void generate_grey_branch(Graph& graph,
                             VertexId from_vertex_id,
                             GraphDepth depth,
-                            std::mutex& grey_edges_mutex) const;
-  void generate_grey_edges(Graph& graph) const;
+                            std::mutex& grey_edges_mutex,
+                            const GenerationGuard& generation_guard) const;
+  void generate_grey_edges(Graph& graph,
+                           const GenerationGuard& generation_guard,
+                           int threads_count) const;
   void generate_green_edges(Graph& graph,
-                            std::mutex& colored_edges_mutex) const;
+                            std::mutex& colored_edges_mutex,
+                            const GenerationGuard& generation_guard) const;
   void generate_yellow_edges(Graph& graph,
-                             std::mutex& colored_edges_mutex) const;
-  void generate_red_edges(Graph& graph, std::mutex& colored_edges_mutex) const;
+                             std::mutex& colored_edges_mutex,
+                             const GenerationGuard& generation_guard) const;
+  void generate_red_edges(Graph& graph,
+                          std::mutex& colored_edges_mutex,
+                          const GenerationGuard& generation_guard) const;
 
   std::unique_ptr<IGraph> generate() const;
+  std::unique_ptr<IGraph> generate(const GenerationGuard& generation_guard,
+                                   int threads_count) const;
 
  private:
   Params params_ = Params(0, 0);
@@ -32,7 +32,11 @@ std::string print_graph(const IGraph& graph) {
     if (depth != kDefaultDepth) {
       graph_print_stream << ",";
     }
-    graph_print_stream << " " << graph.get_depth_vertex_ids(depth).size();
+    const auto depth_vertex_range = graph.get_depth_vertex_range(depth);
+    graph_print_stream << " "
+                       << (depth_vertex_range
+                               ? depth_vertex_range->size()
+                               : graph.get_depth_vertex_ids(depth).size());
   }
 
   graph_print_stream << "]}," << std::endl
@@ -0,0 +1,307 @@
+#include "graph_replay_cache.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "graph.hpp"
+
+namespace {
+
+using uni_course_cpp::EdgeColor;
+using uni_course_cpp::Graph;
+using uni_course_cpp::IEdge;
+using uni_course_cpp::IGraph;
+
+static constexpr uint32_t kFileMagic = 0x43474355;
+static constexpr uint32_t kFormatVersion = 1;
+static constexpr uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ull;
+static constexpr uint64_t kFnvPrime = 0x100000001b3ull;
+static constexpr uni_course_cpp::GraphDepth kDefaultDepth = 1;
+const std::string kCacheFileExtension = ".graph";
+const std::string kTemporaryFileExtension = ".tmp";
+
+uint64_t calculate_checksum(const char* data, size_t size) {
+  uint64_t checksum = kFnvOffsetBasis;
+  for (size_t i = 0; i < size; ++i) {
+    checksum ^= static_cast<unsigned char>(data[i]);
+    checksum *= kFnvPrime;
+  }
+  return checksum;
+}
+
+template <typename T>
+void write_value(std::string& buffer, T value) {
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void read_value(const std::string& buffer, size_t& offset, T& value) {
+  if (offset + sizeof(T) > buffer.size()) {
+    throw std::runtime_error("Unexpected end of cached graph");
+  }
+  std::copy_n(buffer.data() + offset, sizeof(T),
+              reinterpret_cast<char*>(&value));
+  offset += sizeof(T);
+}
+
+struct CachedEdge {
+  int32_t from_vertex_id = 0;
+  int32_t to_vertex_id = 0;
+  uint8_t color = 0;
+};
+
+std::string serialize_graph(const IGraph& graph) {
+  auto edges = std::vector<CachedEdge>(graph.edges_count());
+  graph.for_each_edge([&edges](const IEdge& edge) {
+    if (edge.id() < 0 || edge.id() >= static_cast<int>(edges.size())) {
+      throw std::runtime_error("Graph edge ids are not dense");
+    }
+    edges[edge.id()] = CachedEdge{edge.from_vertex_id(), edge.to_vertex_id(),
+                                  static_cast<uint8_t>(edge.color())};
+  });
+
+  std::string payload;
+  payload.reserve(3 * sizeof(int32_t) + sizeof(uint8_t) +
+                  edges.size() * (2 * sizeof(int32_t) + sizeof(uint8_t)));
+  write_value<int32_t>(payload, graph.vertices_count());
+  write_value<int32_t>(payload, graph.edges_count());
+  write_value<int32_t>(payload, graph.depth());
+  write_value<uint8_t>(payload,
+                       graph.get_depth_vertex_range(kDefaultDepth) ? 1 : 0);
+  for (const auto& edge : edges) {
+    write_value(payload, edge.from_vertex_id);
+    write_value(payload, edge.to_vertex_id);
+    write_value(payload, edge.color);
+  }
+  return payload;
+}
+
+std::unique_ptr<IGraph> deserialize_graph(const std::string& payload) {
+  size_t offset = 0;
+  int32_t vertices_count = 0;
+  int32_t edges_count = 0;
+  int32_t depth = 0;
+  uint8_t is_depth_ordered = 0;
+  read_value(payload, offset, vertices_count);
+  read_value(payload, offset, edges_count);
+  read_value(payload, offset, depth);
+  read_value(payload, offset, is_depth_ordered);
+  if (vertices_count < 0 || edges_count < 0) {
+    throw std::runtime_error("Invalid cached graph size");
+  }
+
+  auto endpoints = std::vector<Graph::EdgeEndpoints>();
+  auto colors = std::vector<uint8_t>();
+  endpoints.reserve(edges_count);
+  colors.reserve(edges_count);
+  for (int32_t i = 0; i < edges_count; ++i) {
+    CachedEdge edge;
+    read_value(payload, offset, edge.from_vertex_id);
+    read_value(payload, offset, edge.to_vertex_id);
+    read_value(payload, offset, edge.color);
+    if (edge.from_vertex_id < 0 || edge.from_vertex_id >= vertices_count ||
+        edge.to_vertex_id < 0 || edge.to_vertex_id >= vertices_count) {
+      throw std::runtime_error("Invalid cached edge");
+    }
+    endpoints.emplace_back(edge.from_vertex_id, edge.to_vertex_id);
+    colors.push_back(edge.color);
+  }
+
+  auto graph = Graph();
+  for (int32_t i = 0; i < vertices_count; ++i) {
+    graph.add_vertex();
+  }
+  graph.add_edges(endpoints);
+  if (is_depth_ordered) {
+    graph.renumber_vertices_by_depth();
+  }
+
+  bool are_colors_matching = true;
+  graph.for_each_edge([&colors, &are_colors_matching](const IEdge& edge) {
+    if (static_cast<uint8_t>(edge.color()) != colors[edge.id()]) {
+      are_colors_matching = false;
+    }
+  });
+  if (!are_colors_matching || graph.depth() != depth) {
+    throw std::runtime_error("Cached graph does not match its description");
+  }
+  return std::make_unique<Graph>(std::move(graph));
+}
+
+std::string get_key_file_name(const std::string& key_string) {
+  std::ostringstream file_name_stream;
+  file_name_stream << std::hex << std::setw(16) << std::setfill('0')
+                   << calculate_checksum(key_string.data(), key_string.size())
+                   << kCacheFileExtension;
+  return file_name_stream.str();
+}
+
+}  // namespace
+
+namespace uni_course_cpp {
+
+GraphReplayCache::Key::Key(const GraphGenerator::Params& params, int index) {
+  std::ostringstream key_stream;
+  key_stream << "depth=" << params.depth()
+             << ";new_vertices_count=" << params.new_vertices_count()
+             << ";renumber_vertices_by_depth="
+             << params.renumber_vertices_by_depth() << ";index=" << index
+             << ";generator_version=" << GraphGenerator::kVersion;
+  string_ = key_stream.str();
+  file_name_ = get_key_file_name(string_);
+}
+
+GraphReplayCache::GraphReplayCache(const std::string& directory_path,
+                                   size_t max_size_bytes)
+    : directory_path_(directory_path), max_size_bytes_(max_size_bytes) {
+  std::filesystem::create_directories(directory_path_);
+  evict();
+}
+
+std::unique_ptr<IGraph> GraphReplayCache::load(const Key& key) {
+  const auto file_path = directory_path_ + key.file_name();
+  std::ifstream cache_file(file_path, std::ios::binary);
+  if (!cache_file)
+    return nullptr;
+  const auto buffer = std::string(std::istreambuf_iterator<char>(cache_file),
+                                  std::istreambuf_iterator<char>());
+  cache_file.close();
+
+  try {
+    size_t offset = 0;
+    uint32_t magic = 0;
+    uint32_t format_version = 0;
+    uint32_t key_size = 0;
+    uint64_t checksum = 0;
+    uint64_t payload_size = 0;
+    read_value(buffer, offset, magic);
+    read_value(buffer, offset, format_version);
+    read_value(buffer, offset, key_size);
+    if (magic != kFileMagic || format_version != kFormatVersion ||
+        offset + key_size > buffer.size() ||
+        buffer.compare(offset, key_size, key.string()) != 0) {
+      throw std::runtime_error("Cached graph header mismatch");
+    }
+    offset += key_size;
+    read_value(buffer, offset, checksum);
+    read_value(buffer, offset, payload_size);
+    if (offset + payload_size != buffer.size() ||
+        calculate_checksum(buffer.data() + offset, payload_size) != checksum) {
+      throw std::runtime_error("Cached graph checksum mismatch");
+    }
+
+    auto graph = deserialize_graph(buffer.substr(offset));
+    std::error_code error_code;
+    std::filesystem::last_write_time(
+        file_path, std::filesystem::file_time_type::clock::now(), error_code);
+    return graph;
+  } catch (const std::runtime_error&) {
+    const std::lock_guard lock(mutex_);
+    std::error_code error_code;
+    auto file_size = std::filesystem::file_size(file_path, error_code);
+    if (error_code) {
+      file_size = 0;
+    }
+    if (std::filesystem::remove(file_path, error_code)) {
+      total_size_bytes_ -= std::min(total_size_bytes_, file_size);
+    }
+    return nullptr;
+  }
+}
+
+void GraphReplayCache::store(const Key& key, const IGraph& graph) {
+  const auto payload = serialize_graph(graph);
+  std::string buffer;
+  buffer.reserve(payload.size() + key.string().size() + 32);
+  write_value(buffer, kFileMagic);
+  write_value(buffer, kFormatVersion);
+  write_value<uint32_t>(buffer, key.string().size());
+  buffer.append(key.string());
+  write_value<uint64_t>(buffer,
+                        calculate_checksum(payload.data(), payload.size()));
+  write_value<uint64_t>(buffer, payload.size());
+  buffer.append(payload);
+
+  const auto file_path = directory_path_ + key.file_name();
+  std::ostringstream temporary_path_stream;
+  temporary_path_stream << file_path << "."
+                        << std::hash<std::thread::id>()(
+                               std::this_thread::get_id())
+                        << kTemporaryFileExtension;
+  const auto temporary_path = temporary_path_stream.str();
+  {
+    std::ofstream cache_file(temporary_path, std::ios::binary);
+    cache_file.write(buffer.data(), buffer.size());
+    if (!cache_file)
+      return;
+  }
+
+  const std::lock_guard lock(mutex_);
+  std::error_code error_code;
+  auto replaced_file_size = std::filesystem::file_size(file_path, error_code);
+  if (error_code) {
+    replaced_file_size = 0;
+  }
+  std::filesystem::rename(temporary_path, file_path, error_code);
+  if (error_code) {
+    std::filesystem::remove(temporary_path, error_code);
+    return;
+  }
+  total_size_bytes_ -= std::min(total_size_bytes_, replaced_file_size);
+  total_size_bytes_ += buffer.size();
+  if (total_size_bytes_ > max_size_bytes_) {
+    evict();
+  }
+}
+
+void GraphReplayCache::evict() {
+  struct CacheEntry {
+    std::filesystem::path path;
+    std::filesystem::file_time_type last_write_time;
+    uintmax_t size = 0;
+  };
+
+  std::error_code error_code;
+  auto entries = std::vector<CacheEntry>();
+  uintmax_t total_size = 0;
+  for (const auto& directory_entry :
+       std::filesystem::directory_iterator(directory_path_, error_code)) {
+    if (directory_entry.path().extension() != kCacheFileExtension)
+      continue;
+    CacheEntry entry;
+    entry.path = directory_entry.path();
+    entry.size = directory_entry.file_size(error_code);
+    if (error_code)
+      continue;
+    entry.last_write_time = directory_entry.last_write_time(error_code);
+    if (error_code)
+      continue;
+    total_size += entry.size;
+    entries.push_back(std::move(entry));
+  }
+  total_size_bytes_ = total_size;
+  if (total_size <= max_size_bytes_)
+    return;
+
+  std::sort(entries.begin(), entries.end(),
+            [](const CacheEntry& lhs, const CacheEntry& rhs) {
+              return lhs.last_write_time < rhs.last_write_time;
+            });
+  for (const auto& entry : entries) {
+    if (total_size <= max_size_bytes_)
+      break;
+    if (std::filesystem::remove(entry.path, error_code)) {
+      total_size -= entry.size;
+    }
+  }
+  total_size_bytes_ = total_size;
+}
+
+}  // namespace uni_course_cpp
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "graph_generator.hpp"
+#include "interfaces/i_graph.hpp"
+
+namespace uni_course_cpp {
+
+// Replays the graph stored for (params, job index). Generation itself is
+// random, so while the cache is enabled every run returns the same graph
+// for the same index; clear the directory to get fresh graphs.
+class GraphReplayCache {
+ public:
+  struct Key {
+   public:
+    Key(const GraphGenerator::Params& params, int index);
+    const std::string& string() const { return string_; }
+    const std::string& file_name() const { return file_name_; }
+
+   private:
+    std::string string_;
+    std::string file_name_;
+  };
+
+  GraphReplayCache(const std::string& directory_path, size_t max_size_bytes);
+
+  std::unique_ptr<IGraph> load(const Key& key);
+  void store(const Key& key, const IGraph& graph);
+
+ private:
+  void evict();
+
+  std::string directory_path_;
+  size_t max_size_bytes_ = 0;
+  uintmax_t total_size_bytes_ = 0;
+  std::mutex mutex_;
+};
+
+}  // namespace uni_course_cpp
@@ -0,0 +1,235 @@
+#include "graph_traversal.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "parallel_for.hpp"
+
+namespace {
+
+using uni_course_cpp::VertexId;
+
+static constexpr int kBitsPerWord = 64;
+static constexpr int kMinVerticesPerThread = 4096;
+static constexpr int kTopDownToBottomUpFactor = 14;
+static constexpr int kBottomUpToTopDownFactor = 24;
+
+struct AdjacencyArrays {
+  std::vector<int> offsets;
+  std::vector<VertexId> vertex_ids;
+
+  int degree(VertexId id) const { return offsets[id + 1] - offsets[id]; }
+};
+
+class AtomicBitmap {
+ public:
+  explicit AtomicBitmap(int bits_count)
+      : words_((bits_count + kBitsPerWord - 1) / kBitsPerWord) {
+    clear();
+  }
+
+  void clear() {
+    for (auto& word : words_) {
+      word.store(0, std::memory_order_relaxed);
+    }
+  }
+  bool test(int index) const {
+    return words_[index / kBitsPerWord].load(std::memory_order_relaxed) &
+           get_mask(index);
+  }
+  bool test_and_set(int index) {
+    const auto mask = get_mask(index);
+    return words_[index / kBitsPerWord].fetch_or(
+               mask, std::memory_order_relaxed) &
+           mask;
+  }
+
+ private:
+  static uint64_t get_mask(int index) {
+    return uint64_t(1) << (index % kBitsPerWord);
+  }
+
+  std::vector<std::atomic<uint64_t>> words_;
+};
+
+struct Adjacency {
+  AdjacencyArrays outgoing;
+  AdjacencyArrays incoming;
+};
+
+Adjacency build_adjacency(const uni_course_cpp::IGraph& graph,
+                          const std::vector<uni_course_cpp::EdgeColor>&
+                              edge_colors) {
+  const int vertices_count = graph.vertices_count();
+  std::array<bool, 4> is_color_allowed = {false, false, false, false};
+  for (const auto color : edge_colors) {
+    is_color_allowed[static_cast<int>(color)] = true;
+  }
+  const auto is_edge_allowed = [&is_color_allowed](
+                                   const uni_course_cpp::IEdge& edge) {
+    return is_color_allowed[static_cast<int>(edge.color())] &&
+           edge.from_vertex_id() != edge.to_vertex_id();
+  };
+
+  Adjacency adjacency;
+  adjacency.outgoing.offsets.assign(vertices_count + 1, 0);
+  adjacency.incoming.offsets.assign(vertices_count + 1, 0);
+  graph.for_each_edge([&adjacency, &is_edge_allowed](
+                          const uni_course_cpp::IEdge& edge) {
+    if (is_edge_allowed(edge)) {
+      ++adjacency.outgoing.offsets[edge.from_vertex_id() + 1];
+      ++adjacency.incoming.offsets[edge.to_vertex_id() + 1];
+    }
+  });
+  for (int i = 0; i < vertices_count; ++i) {
+    adjacency.outgoing.offsets[i + 1] += adjacency.outgoing.offsets[i];
+    adjacency.incoming.offsets[i + 1] += adjacency.incoming.offsets[i];
+  }
+
+  adjacency.outgoing.vertex_ids.resize(
+      adjacency.outgoing.offsets[vertices_count]);
+  adjacency.incoming.vertex_ids.resize(
+      adjacency.incoming.offsets[vertices_count]);
+  auto outgoing_positions = std::vector<int>(
+      adjacency.outgoing.offsets.cbegin(),
+      adjacency.outgoing.offsets.cend() - 1);
+  auto incoming_positions = std::vector<int>(
+      adjacency.incoming.offsets.cbegin(),
+      adjacency.incoming.offsets.cend() - 1);
+  graph.for_each_edge([&adjacency, &is_edge_allowed, &outgoing_positions,
+                       &incoming_positions](
+                          const uni_course_cpp::IEdge& edge) {
+    if (is_edge_allowed(edge)) {
+      adjacency.outgoing
+          .vertex_ids[outgoing_positions[edge.from_vertex_id()]++] =
+          edge.to_vertex_id();
+      adjacency.incoming
+          .vertex_ids[incoming_positions[edge.to_vertex_id()]++] =
+          edge.from_vertex_id();
+    }
+  });
+  return adjacency;
+}
+
+int get_step_threads_count(int work_size, int threads_count) {
+  return std::max(1, std::min(threads_count, work_size / kMinVerticesPerThread));
+}
+
+std::vector<VertexId> merge_frontiers(
+    std::vector<std::vector<VertexId>>& thread_frontiers) {
+  std::vector<VertexId> frontier;
+  for (auto& thread_frontier : thread_frontiers) {
+    frontier.insert(frontier.end(), thread_frontier.cbegin(),
+                    thread_frontier.cend());
+    thread_frontier.clear();
+  }
+  return frontier;
+}
+
+}  // namespace
+
+namespace uni_course_cpp {
+
+BfsResult breadth_first_search(const IGraph& graph,
+                               VertexId source_vertex_id,
+                               const std::vector<EdgeColor>& edge_colors,
+                               int threads_count) {
+  const int vertices_count = graph.vertices_count();
+  BfsResult result;
+  result.distances.assign(vertices_count, kUnreachableDistance);
+  if (source_vertex_id < 0 || source_vertex_id >= vertices_count)
+    return result;
+
+  threads_count = std::max(1, threads_count);
+  const auto adjacency = build_adjacency(graph, edge_colors);
+  auto visited = AtomicBitmap(vertices_count);
+  auto frontier_bitmap = AtomicBitmap(vertices_count);
+  auto thread_frontiers = std::vector<std::vector<VertexId>>(threads_count);
+
+  auto frontier = std::vector<VertexId>{source_vertex_id};
+  visited.test_and_set(source_vertex_id);
+  result.distances[source_vertex_id] = 0;
+
+  int64_t unexplored_edges_count = adjacency.outgoing.vertex_ids.size();
+  bool is_bottom_up = false;
+
+  for (int distance = 0; !frontier.empty(); ++distance) {
+    result.level_sizes.push_back(frontier.size());
+    result.reachable_count += frontier.size();
+
+    int64_t frontier_edges_count = 0;
+    for (const auto vertex_id : frontier) {
+      frontier_edges_count += adjacency.outgoing.degree(vertex_id);
+    }
+    unexplored_edges_count -= frontier_edges_count;
+
+    if (!is_bottom_up && frontier_edges_count >
+                             unexplored_edges_count / kTopDownToBottomUpFactor) {
+      is_bottom_up = true;
+    } else if (is_bottom_up && static_cast<int64_t>(frontier.size()) <
+                                   vertices_count / kBottomUpToTopDownFactor) {
+      is_bottom_up = false;
+    }
+
+    const int next_distance = distance + 1;
+    if (is_bottom_up) {
+      frontier_bitmap.clear();
+      for (const auto vertex_id : frontier) {
+        frontier_bitmap.test_and_set(vertex_id);
+      }
+      parallel_for(
+          0, vertices_count,
+          get_step_threads_count(vertices_count, threads_count),
+          [&adjacency, &visited, &frontier_bitmap, &thread_frontiers, &result,
+           next_distance](int thread_index, int vertex_begin, int vertex_end) {
+            auto& next_frontier = thread_frontiers[thread_index];
+            for (VertexId vertex_id = vertex_begin; vertex_id < vertex_end;
+                 ++vertex_id) {
+              if (visited.test(vertex_id))
+                continue;
+              const auto parents_begin =
+                  adjacency.incoming.vertex_ids.cbegin() +
+                  adjacency.incoming.offsets[vertex_id];
+              const auto parents_end = adjacency.incoming.vertex_ids.cbegin() +
+                                       adjacency.incoming.offsets[vertex_id + 1];
+              const auto has_frontier_parent = std::any_of(
+                  parents_begin, parents_end,
+                  [&frontier_bitmap](VertexId parent_vertex_id) {
+                    return frontier_bitmap.test(parent_vertex_id);
+                  });
+              if (has_frontier_parent &&
+                  !visited.test_and_set(vertex_id)) {
+                result.distances[vertex_id] = next_distance;
+                next_frontier.push_back(vertex_id);
+              }
+            }
+          });
+    } else {
+      parallel_for(
+          0, frontier.size(),
+          get_step_threads_count(frontier.size(), threads_count),
+          [&adjacency, &visited, &frontier, &thread_frontiers, &result,
+           next_distance](int thread_index, int frontier_begin,
+                          int frontier_end) {
+            auto& next_frontier = thread_frontiers[thread_index];
+            for (int i = frontier_begin; i < frontier_end; ++i) {
+              const auto vertex_id = frontier[i];
+              for (int j = adjacency.outgoing.offsets[vertex_id];
+                   j < adjacency.outgoing.offsets[vertex_id + 1]; ++j) {
+                const auto child_vertex_id = adjacency.outgoing.vertex_ids[j];
+                if (!visited.test(child_vertex_id) &&
+                    !visited.test_and_set(child_vertex_id)) {
+                  result.distances[child_vertex_id] = next_distance;
+                  next_frontier.push_back(child_vertex_id);
+                }
+              }
+            }
+          });
+    }
+    frontier = merge_frontiers(thread_frontiers);
+  }
+
+  return result;
+}
+
+}  // namespace uni_course_cpp
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <vector>
+#include "interfaces/i_graph.hpp"
+
+namespace uni_course_cpp {
+
+static constexpr int kUnreachableDistance = -1;
+
+struct BfsResult {
+  std::vector<int> distances;
+  std::vector<int> level_sizes;
+  int reachable_count = 0;
+
+  int max_distance() const { return level_sizes.size() - 1; }
+};
+
+BfsResult breadth_first_search(const IGraph& graph,
+                               VertexId source_vertex_id,
+                               const std::vector<EdgeColor>& edge_colors,
+                               int threads_count);
+
+}  // namespace uni_course_cpp
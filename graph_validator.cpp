@@ -0,0 +1,265 @@
+#include "graph_validator.hpp"
+#include <algorithm>
+#include <sstream>
+#include "graph_printer.hpp"
+#include "parallel_for.hpp"
+
+namespace {
+
+using uni_course_cpp::EdgeColor;
+using uni_course_cpp::GraphDepth;
+using uni_course_cpp::IEdge;
+using uni_course_cpp::IGraph;
+using uni_course_cpp::IVertex;
+using uni_course_cpp::ValidationReport;
+using uni_course_cpp::VertexId;
+
+static constexpr GraphDepth kDefaultDepth = 1;
+static constexpr GraphDepth kGreyDepthStep = 1;
+static constexpr GraphDepth kYellowDepthStep = 1;
+static constexpr GraphDepth kRedDepthStep = 2;
+static constexpr int kMaxReportedViolationsCount = 32;
+static constexpr int kMinItemsPerThread = 2048;
+
+class ViolationCollector {
+ public:
+  void add(const std::string& violation) {
+    ++report_.violations_count;
+    if (report_.violations.size() < kMaxReportedViolationsCount) {
+      report_.violations.push_back(violation);
+    }
+  }
+
+  void merge_into(ValidationReport& report) const {
+    report.violations_count += report_.violations_count;
+    for (const auto& violation : report_.violations) {
+      if (report.violations.size() >= kMaxReportedViolationsCount)
+        break;
+      report.violations.push_back(violation);
+    }
+  }
+
+ private:
+  ValidationReport report_;
+};
+
+std::string edge_violation_string(const IEdge& edge, const std::string& text) {
+  std::ostringstream output;
+  output << "edge " << edge.id() << " ("
+         << uni_course_cpp::printing::print_edge_color(edge.color()) << ", "
+         << edge.from_vertex_id() << " -> " << edge.to_vertex_id()
+         << "): " << text;
+  return output.str();
+}
+
+std::string vertex_violation_string(VertexId id, const std::string& text) {
+  std::ostringstream output;
+  output << "vertex " << id << ": " << text;
+  return output.str();
+}
+
+bool is_vertex_id_valid(const IGraph& graph, VertexId id) {
+  return id >= 0 && id < graph.vertices_count();
+}
+
+bool has_duplicate_edge(const IGraph& graph,
+                        const IEdge& edge,
+                        const std::vector<const IEdge*>& edges_by_id) {
+  const auto& from_edge_ids =
+      graph.get_connected_edge_ids(edge.from_vertex_id());
+  for (const auto edge_id : from_edge_ids) {
+    if (edge_id == edge.id() || edge_id < 0 ||
+        edge_id >= static_cast<int>(edges_by_id.size()))
+      continue;
+    const auto& other_edge = *edges_by_id[edge_id];
+    if ((other_edge.from_vertex_id() == edge.from_vertex_id() &&
+         other_edge.to_vertex_id() == edge.to_vertex_id()) ||
+        (other_edge.from_vertex_id() == edge.to_vertex_id() &&
+         other_edge.to_vertex_id() == edge.from_vertex_id()))
+      return true;
+  }
+  return false;
+}
+
+void validate_edge(const IGraph& graph,
+                   const IEdge& edge,
+                   const std::vector<const IEdge*>& edges_by_id,
+                   ViolationCollector& collector) {
+  const auto from_vertex_id = edge.from_vertex_id();
+  const auto to_vertex_id = edge.to_vertex_id();
+  if (!is_vertex_id_valid(graph, from_vertex_id) ||
+      !is_vertex_id_valid(graph, to_vertex_id)) {
+    collector.add(edge_violation_string(edge, "unknown vertex id"));
+    return;
+  }
+
+  const auto& from_edge_ids = graph.get_connected_edge_ids(from_vertex_id);
+  const auto& to_edge_ids = graph.get_connected_edge_ids(to_vertex_id);
+  if (from_edge_ids.find(edge.id()) == from_edge_ids.cend() ||
+      to_edge_ids.find(edge.id()) == to_edge_ids.cend()) {
+    collector.add(edge_violation_string(edge, "missing from adjacency list"));
+  }
+
+  const auto depth_step = graph.get_vertex_depth(to_vertex_id) -
+                          graph.get_vertex_depth(from_vertex_id);
+  switch (edge.color()) {
+    case EdgeColor::Grey:
+      if (depth_step != kGreyDepthStep) {
+        collector.add(edge_violation_string(edge, "spans wrong depth"));
+      }
+      break;
+    case EdgeColor::Green:
+      if (from_vertex_id != to_vertex_id) {
+        collector.add(edge_violation_string(edge, "is not a loop"));
+      }
+      break;
+    case EdgeColor::Yellow:
+      if (depth_step != kYellowDepthStep) {
+        collector.add(edge_violation_string(edge, "spans wrong depth"));
+      }
+      if (has_duplicate_edge(graph, edge, edges_by_id)) {
+        collector.add(edge_violation_string(edge, "duplicates another edge"));
+      }
+      break;
+    case EdgeColor::Red:
+      if (depth_step != kRedDepthStep) {
+        collector.add(edge_violation_string(edge, "spans wrong depth"));
+      }
+      break;
+  }
+}
+
+void validate_vertex(const IGraph& graph,
+                     VertexId vertex_id,
+                     const std::vector<const IEdge*>& edges_by_id,
+                     ViolationCollector& collector) {
+  int grey_parents_count = 0;
+  for (const auto edge_id : graph.get_connected_edge_ids(vertex_id)) {
+    if (edge_id < 0 || edge_id >= static_cast<int>(edges_by_id.size())) {
+      collector.add(vertex_violation_string(vertex_id, "unknown edge id"));
+      continue;
+    }
+    const auto& edge = *edges_by_id[edge_id];
+    if (edge.from_vertex_id() != vertex_id &&
+        edge.to_vertex_id() != vertex_id) {
+      collector.add(
+          vertex_violation_string(vertex_id, "lists a foreign edge"));
+    }
+    if (edge.color() == EdgeColor::Grey && edge.to_vertex_id() == vertex_id) {
+      ++grey_parents_count;
+    }
+  }
+
+  const auto depth = graph.get_vertex_depth(vertex_id);
+  const int expected_grey_parents_count = depth == kDefaultDepth ? 0 : 1;
+  if (grey_parents_count != expected_grey_parents_count) {
+    collector.add(
+        vertex_violation_string(vertex_id, "wrong number of grey parents"));
+  }
+  if (depth < kDefaultDepth || depth > graph.depth()) {
+    collector.add(vertex_violation_string(vertex_id, "depth out of range"));
+    return;
+  }
+  const auto& depth_vertex_ids = graph.get_depth_vertex_ids(depth);
+  if (depth_vertex_ids.find(vertex_id) == depth_vertex_ids.cend()) {
+    collector.add(vertex_violation_string(vertex_id, "missing from its layer"));
+  }
+}
+
+int get_threads_count(int items_count, int threads_count) {
+  return std::max(1, std::min(threads_count, items_count / kMinItemsPerThread));
+}
+
+}  // namespace
+
+namespace uni_course_cpp {
+
+ValidationReport validate_graph(const IGraph& graph, int threads_count) {
+  ValidationReport report;
+  const int vertices_count = graph.vertices_count();
+  const int edges_count = graph.edges_count();
+
+  auto edges_by_id = std::vector<const IEdge*>(edges_count, nullptr);
+  auto vertex_ids = std::vector<VertexId>();
+  vertex_ids.reserve(vertices_count);
+  ViolationCollector collector;
+  graph.for_each_edge([&edges_by_id, &collector,
+                       edges_count](const IEdge& edge) {
+    if (edge.id() < 0 || edge.id() >= edges_count ||
+        edges_by_id[edge.id()] != nullptr) {
+      collector.add(edge_violation_string(edge, "invalid or repeated id"));
+      return;
+    }
+    edges_by_id[edge.id()] = &edge;
+  });
+  graph.for_each_vertex([&vertex_ids, &graph,
+                         &collector](const IVertex& vertex) {
+    if (!is_vertex_id_valid(graph, vertex.id())) {
+      collector.add(vertex_violation_string(vertex.id(), "invalid id"));
+      return;
+    }
+    vertex_ids.push_back(vertex.id());
+  });
+  if (vertices_count > 0 &&
+      graph.get_depth_vertex_ids(kDefaultDepth).size() != 1) {
+    collector.add("graph must have exactly one root vertex");
+  }
+  int layers_vertices_count = 0;
+  for (GraphDepth depth = kDefaultDepth; depth <= graph.depth(); ++depth) {
+    layers_vertices_count += graph.get_depth_vertex_ids(depth).size();
+  }
+  if (layers_vertices_count != vertices_count) {
+    collector.add("layers do not cover all vertices exactly once");
+  }
+  collector.merge_into(report);
+  if (!report.is_valid())
+    return report;
+
+  threads_count = std::max(1, threads_count);
+  auto thread_collectors = std::vector<ViolationCollector>(threads_count);
+  parallel_for(0, edges_count, get_threads_count(edges_count, threads_count),
+               [&graph, &edges_by_id, &thread_collectors](
+                   int thread_index, int edge_begin, int edge_end) {
+                 for (int i = edge_begin; i < edge_end; ++i) {
+                   validate_edge(graph, *edges_by_id[i], edges_by_id,
+                                 thread_collectors[thread_index]);
+                 }
+               });
+  parallel_for(0, vertex_ids.size(),
+               get_threads_count(vertex_ids.size(), threads_count),
+               [&graph, &vertex_ids, &edges_by_id, &thread_collectors](
+                   int thread_index, int vertex_begin, int vertex_end) {
+                 for (int i = vertex_begin; i < vertex_end; ++i) {
+                   validate_vertex(graph, vertex_ids[i], edges_by_id,
+                                   thread_collectors[thread_index]);
+                 }
+               });
+
+  for (const auto& thread_collector : thread_collectors) {
+    thread_collector.merge_into(report);
+  }
+  return report;
+}
+
+namespace printing {
+
+std::string print_validation_report(const ValidationReport& report) {
+  std::ostringstream report_print_stream;
+  if (report.is_valid()) {
+    report_print_stream << "Validation Passed";
+    return report_print_stream.str();
+  }
+  report_print_stream << "Validation Failed, violations: "
+                      << report.violations_count << " {";
+  for (const auto& violation : report.violations) {
+    report_print_stream << std::endl << "\t" << violation;
+  }
+  if (report.violations_count > static_cast<int>(report.violations.size())) {
+    report_print_stream << std::endl << "\t...";
+  }
+  report_print_stream << std::endl << "}";
+  return report_print_stream.str();
+}
+
+}  // namespace printing
+}  // namespace uni_course_cpp
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "interfaces/i_graph.hpp"
+
+namespace uni_course_cpp {
+
+struct ValidationReport {
+  int violations_count = 0;
+  std::vector<std::string> violations;
+
+  bool is_valid() const { return violations_count == 0; }
+};
+
+ValidationReport validate_graph(const IGraph& graph, int threads_count);
+
+namespace printing {
+std::string print_validation_report(const ValidationReport& report);
+}  // namespace printing
+
+}  // namespace uni_course_cpp
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <functional>
+#include <optional>
 #include <unordered_set>
 
 #include "i_edge.hpp"
@@ -10,6 +12,26 @@ namespace uni_course_cpp {
 
 using GraphDepth = int;
 
+struct VertexRange {
+  VertexId begin = 0;
+  VertexId end = 0;
+
+  int size() const { return end - begin; }
+};
+
+struct GraphMemoryUsage {
+  size_t edges_bytes = 0;
+  size_t vertices_bytes = 0;
+  size_t adjacency_list_bytes = 0;
+  size_t depth_vertex_ids_bytes = 0;
+  size_t vertex_depths_bytes = 0;
+
+  size_t total_bytes() const {
+    return edges_bytes + vertices_bytes + adjacency_list_bytes +
+           depth_vertex_ids_bytes + vertex_depths_bytes;
+  }
+};
+
 class IGraph {
  public:
   virtual ~IGraph(){};
@@ -31,6 +53,9 @@ class IGraph {
 
   virtual const std::unordered_set<VertexId>& get_depth_vertex_ids(
       GraphDepth depth) const = 0;
+  virtual std::optional<VertexRange> get_depth_vertex_range(
+      GraphDepth depth) const = 0;
+  virtual GraphMemoryUsage memory_usage() const = 0;
 };
 
 }  // namespace uni_course_cpp
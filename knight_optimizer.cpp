@@ -0,0 +1,235 @@
+#include "knight_optimizer.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <optional>
+#include <random>
+#include <vector>
+#include "parallel_for.hpp"
+
+namespace {
+
+using uni_course_cpp::BattleTable;
+using uni_course_cpp::EnemyType;
+using uni_course_cpp::FighterStats;
+using uni_course_cpp::KnightOptimizer;
+using uni_course_cpp::VertexId;
+
+static constexpr uni_course_cpp::GraphDepth kDefaultDepth = 1;
+static constexpr int kStatsCount = 3;
+static constexpr int kStatPointsCount = 30;
+static constexpr int kMaxMutationStep = 3;
+static constexpr int kElitesDivider = 4;
+static constexpr float kBaseHealth = 50.0f;
+static constexpr float kHealthPerPoint = 5.0f;
+static constexpr float kBaseStamina = 2.0f;
+static constexpr float kStaminaPerPoint = 1.0f;
+static constexpr float kBaseAttack = 5.0f;
+static constexpr float kAttackPerPoint = 1.0f;
+
+using StatPoints = std::array<int, kStatsCount>;
+
+FighterStats to_fighter_stats(const StatPoints& stat_points) {
+  return FighterStats(kBaseHealth + stat_points[0] * kHealthPerPoint,
+                      kBaseStamina + stat_points[1] * kStaminaPerPoint,
+                      kBaseAttack + stat_points[2] * kAttackPerPoint);
+}
+
+StatPoints get_random_stat_points(std::mt19937& gen) {
+  std::uniform_int_distribution distribution(0, kStatPointsCount);
+  auto first_cut = distribution(gen);
+  auto second_cut = distribution(gen);
+  if (first_cut > second_cut)
+    std::swap(first_cut, second_cut);
+  return {first_cut, second_cut - first_cut, kStatPointsCount - second_cut};
+}
+
+StatPoints mutate_stat_points(StatPoints stat_points, std::mt19937& gen) {
+  std::uniform_int_distribution stat_distribution(0, kStatsCount - 1);
+  std::uniform_int_distribution step_distribution(1, kMaxMutationStep);
+  const int from_stat = stat_distribution(gen);
+  const int to_stat = stat_distribution(gen);
+  const int step = std::min(step_distribution(gen), stat_points[from_stat]);
+  stat_points[from_stat] -= step;
+  stat_points[to_stat] += step;
+  return stat_points;
+}
+
+struct RouteEdge {
+  VertexId from_vertex_id = 0;
+  VertexId to_vertex_id = 0;
+  float encounter_probability = 0;
+  std::optional<EnemyType> enemy_type;
+};
+
+class RouteEvaluator {
+ public:
+  RouteEvaluator(const uni_course_cpp::IGraph& graph,
+                 const uni_course_cpp::EdgeEncounters& edge_encounters)
+      : vertices_count_(graph.vertices_count()),
+        princess_vertex_ids_(
+            graph.get_depth_vertex_ids(graph.depth()).cbegin(),
+            graph.get_depth_vertex_ids(graph.depth()).cend()) {
+    root_vertex_id_ = *graph.get_depth_vertex_ids(kDefaultDepth).cbegin();
+    graph.for_each_edge([this, &edge_encounters](
+                            const uni_course_cpp::IEdge& edge) {
+      if (edge.from_vertex_id() == edge.to_vertex_id())
+        return;
+      RouteEdge route_edge;
+      route_edge.from_vertex_id = edge.from_vertex_id();
+      route_edge.to_vertex_id = edge.to_vertex_id();
+      const auto encounter_it = edge_encounters.find(edge.id());
+      if (encounter_it != edge_encounters.cend()) {
+        route_edge.encounter_probability =
+            uni_course_cpp::get_encounter_probability(edge.color());
+        route_edge.enemy_type = encounter_it->second;
+      }
+      route_edges_.push_back(route_edge);
+    });
+    std::stable_sort(route_edges_.begin(), route_edges_.end(),
+                     [&graph](const RouteEdge& lhs, const RouteEdge& rhs) {
+                       return graph.get_vertex_depth(lhs.from_vertex_id) <
+                              graph.get_vertex_depth(rhs.from_vertex_id);
+                     });
+  }
+
+  KnightOptimizer::Result evaluate(const FighterStats& knight_stats,
+                                   const BattleTable& battle_table) const {
+    auto survival_probabilities = std::vector<float>(vertices_count_, 0.0f);
+    auto expected_damages = std::vector<float>(vertices_count_, 0.0f);
+    survival_probabilities[root_vertex_id_] = 1.0f;
+
+    for (const auto& route_edge : route_edges_) {
+      float death_probability = 0;
+      float expected_damage = 0;
+      if (route_edge.enemy_type) {
+        const auto& outcome = battle_table.at(*route_edge.enemy_type);
+        death_probability = route_edge.encounter_probability *
+                            (1.0f - outcome.win_probability);
+        expected_damage =
+            route_edge.encounter_probability * outcome.expected_damage;
+      }
+      const float survival_probability =
+          survival_probabilities[route_edge.from_vertex_id] *
+          (1.0f - death_probability);
+      const float damage =
+          expected_damages[route_edge.from_vertex_id] + expected_damage;
+      auto& to_survival = survival_probabilities[route_edge.to_vertex_id];
+      auto& to_damage = expected_damages[route_edge.to_vertex_id];
+      if (survival_probability > to_survival ||
+          (survival_probability == to_survival && damage < to_damage)) {
+        to_survival = survival_probability;
+        to_damage = damage;
+      }
+    }
+
+    KnightOptimizer::Result result;
+    result.knight_stats = knight_stats;
+    for (const auto princess_vertex_id : princess_vertex_ids_) {
+      const float survival_probability =
+          survival_probabilities[princess_vertex_id];
+      if (survival_probability > result.route_survival_probability) {
+        result.route_survival_probability = survival_probability;
+        result.route_expected_damage = expected_damages[princess_vertex_id];
+      }
+    }
+    return result;
+  }
+
+ private:
+  int vertices_count_ = 0;
+  VertexId root_vertex_id_ = 0;
+  std::vector<VertexId> princess_vertex_ids_;
+  std::vector<RouteEdge> route_edges_;
+};
+
+bool is_better_result(const KnightOptimizer::Result& lhs,
+                      const KnightOptimizer::Result& rhs) {
+  if (lhs.route_survival_probability != rhs.route_survival_probability)
+    return lhs.route_survival_probability > rhs.route_survival_probability;
+  return lhs.route_expected_damage < rhs.route_expected_damage;
+}
+
+}  // namespace
+
+namespace uni_course_cpp {
+
+KnightOptimizer::Result KnightOptimizer::optimize(
+    const IGraph& graph,
+    const EdgeEncounters& edge_encounters) {
+  if (graph.vertices_count() == 0 || params_.population_size() <= 0)
+    return Result();
+
+  const auto route_evaluator = RouteEvaluator(graph, edge_encounters);
+  const auto battle_simulator =
+      BattleSimulator(BattleSimulator::Params(params_.fights_count(), 1));
+
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  auto population = std::vector<StatPoints>();
+  population.reserve(params_.population_size());
+  for (int i = 0; i < params_.population_size(); ++i) {
+    population.push_back(get_random_stat_points(gen));
+  }
+
+  auto best_result = Result();
+  auto generation_durations_ms = std::vector<double>();
+  generation_durations_ms.reserve(params_.generations_count());
+  auto results = std::vector<Result>(params_.population_size());
+  auto order = std::vector<int>(params_.population_size());
+  const int elites_count =
+      std::max(1, params_.population_size() / kElitesDivider);
+
+  for (int generation = 0; generation < params_.generations_count();
+       ++generation) {
+    const auto start_time = std::chrono::steady_clock::now();
+
+    parallel_for(0, params_.population_size(), params_.threads_count(),
+                 [this, &population, &results, &route_evaluator,
+                  &battle_simulator](int, int candidate_begin,
+                                     int candidate_end) {
+                   for (int i = candidate_begin; i < candidate_end; ++i) {
+                     const auto knight_stats = to_fighter_stats(population[i]);
+                     const auto battle_table =
+                         fight_outcome_cache_.get_or_simulate_all(
+                             knight_stats, battle_simulator);
+                     results[i] =
+                         route_evaluator.evaluate(knight_stats, battle_table);
+                   }
+                 });
+
+    for (int i = 0; i < params_.population_size(); ++i) {
+      order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&results](int lhs, int rhs) {
+      return is_better_result(results[lhs], results[rhs]);
+    });
+    if (generation == 0 || is_better_result(results[order[0]], best_result)) {
+      best_result = results[order[0]];
+    }
+    generation_durations_ms.push_back(
+        std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start_time)
+            .count());
+
+    auto next_population = std::vector<StatPoints>();
+    next_population.reserve(params_.population_size());
+    for (int i = 0; i < elites_count; ++i) {
+      next_population.push_back(population[order[i]]);
+    }
+    std::uniform_int_distribution elite_distribution(0, elites_count - 1);
+    while (static_cast<int>(next_population.size()) <
+           params_.population_size()) {
+      next_population.push_back(
+          mutate_stat_points(next_population[elite_distribution(gen)], gen));
+    }
+    population = std::move(next_population);
+  }
+
+  best_result.cache_hits_count = fight_outcome_cache_.hits_count();
+  best_result.cache_misses_count = fight_outcome_cache_.misses_count();
+  best_result.generation_durations_ms = std::move(generation_durations_ms);
+  return best_result;
+}
+
+}  // namespace uni_course_cpp
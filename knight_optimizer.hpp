@@ -0,0 +1,53 @@
+#pragma once
+
+#include "battle_simulator.hpp"
+#include "edge_encounters.hpp"
+#include "fight_outcome_cache.hpp"
+#include <vector>
+#include "interfaces/i_graph.hpp"
+
+namespace uni_course_cpp {
+
+class KnightOptimizer {
+ public:
+  struct Params {
+   public:
+    Params(int generations_count,
+           int population_size,
+           int fights_count,
+           int threads_count)
+        : generations_count_(generations_count),
+          population_size_(population_size),
+          fights_count_(fights_count),
+          threads_count_(threads_count) {}
+    int generations_count() const { return generations_count_; }
+    int population_size() const { return population_size_; }
+    int fights_count() const { return fights_count_; }
+    int threads_count() const { return threads_count_; }
+
+   private:
+    int generations_count_ = 0;
+    int population_size_ = 0;
+    int fights_count_ = 0;
+    int threads_count_ = 0;
+  };
+
+  struct Result {
+    FighterStats knight_stats = get_default_knight_stats();
+    float route_survival_probability = 0;
+    float route_expected_damage = 0;
+    int cache_hits_count = 0;
+    int cache_misses_count = 0;
+    std::vector<double> generation_durations_ms;
+  };
+
+  explicit KnightOptimizer(Params&& params) : params_(std::move(params)) {}
+
+  Result optimize(const IGraph& graph, const EdgeEncounters& edge_encounters);
+
+ private:
+  Params params_ = Params(0, 0, 0, 0);
+  FightOutcomeCache fight_outcome_cache_;
+};
+
+}  // namespace uni_course_cpp
@@ -0,0 +1,139 @@
+#include "large_graph.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include "graph_printer.hpp"
+#include "memory_tracker.hpp"
+
+namespace {
+
+static constexpr uni_course_cpp::GraphDepth kDefaultDepth = 1;
+const std::string kMetadataFileName = "graph.meta";
+const std::string kEdgeOffsetsFileName = "edge_offsets";
+const std::string kEdgeTargetsFileName = "edge_targets";
+const std::string kEdgeColorsFileName = "edge_colors";
+
+std::string get_directory_path(const std::string& directory_path) {
+  std::filesystem::create_directories(directory_path);
+  return directory_path.empty() || directory_path.back() == '/'
+             ? directory_path
+             : directory_path + "/";
+}
+
+}  // namespace
+
+namespace uni_course_cpp {
+
+LargeGraph::LargeGraph(const std::string& directory_path)
+    : directory_path_(get_directory_path(directory_path)),
+      depth_begins_({0}),
+      edge_offsets_(directory_path_ + kEdgeOffsetsFileName),
+      edge_targets_(directory_path_ + kEdgeTargetsFileName),
+      edge_colors_(directory_path_ + kEdgeColorsFileName) {
+  edge_offsets_.push_back(0);
+}
+
+LargeVertexRange LargeGraph::add_depth(LargeVertexId vertices_count) {
+  const auto begin = depth_begins_.back();
+  depth_begins_.push_back(begin + vertices_count);
+  return {begin, begin + vertices_count};
+}
+
+void LargeGraph::add_out_edge(LargeVertexId to_vertex_id, EdgeColor color) {
+  if (to_vertex_id < 0 || to_vertex_id >= vertices_count()) {
+    throw std::runtime_error("Edge target vertex doesn't exist");
+  }
+  edge_targets_.push_back(to_vertex_id);
+  edge_colors_.push_back(static_cast<std::uint8_t>(color));
+  ++color_edges_counts_[static_cast<int>(color)];
+}
+
+LargeVertexId LargeGraph::finish_vertex() {
+  const auto vertex_id = finished_vertices_count();
+  if (vertex_id >= vertices_count()) {
+    throw std::runtime_error("All vertices already have their edges");
+  }
+  edge_offsets_.push_back(edges_count());
+  return vertex_id;
+}
+
+void LargeGraph::flush() const {
+  edge_offsets_.flush();
+  edge_targets_.flush();
+  edge_colors_.flush();
+
+  std::ofstream metadata_file(directory_path_ + kMetadataFileName);
+  metadata_file << "version " << kVersion << std::endl
+                << "depth " << depth() << std::endl
+                << "vertices " << vertices_count() << std::endl
+                << "edges " << edges_count() << std::endl
+                << "depth_begins";
+  for (const auto depth_begin : depth_begins_) {
+    metadata_file << " " << depth_begin;
+  }
+  metadata_file << std::endl;
+}
+
+LargeVertexRange LargeGraph::get_depth_vertex_range(GraphDepth depth) const {
+  if (depth < kDefaultDepth || depth > this->depth())
+    return {};
+  return {depth_begins_[depth - kDefaultDepth], depth_begins_[depth]};
+}
+
+GraphDepth LargeGraph::get_vertex_depth(LargeVertexId id) const {
+  if (id < 0 || id >= vertices_count()) {
+    throw std::runtime_error("Vertex doesn't exist");
+  }
+  return std::upper_bound(depth_begins_.cbegin(), depth_begins_.cend(), id) -
+         depth_begins_.cbegin();
+}
+
+LargeEdgeRange LargeGraph::get_out_edge_range(LargeVertexId id) const {
+  if (id < 0 || id >= finished_vertices_count()) {
+    throw std::runtime_error("Vertex edges are not generated yet");
+  }
+  return {edge_offsets_[id], edge_offsets_[id + 1]};
+}
+
+size_t LargeGraph::mapped_bytes() const {
+  return edge_offsets_.mapped_bytes() + edge_targets_.mapped_bytes() +
+         edge_colors_.mapped_bytes();
+}
+
+namespace printing {
+std::string print_large_graph(const LargeGraph& graph) {
+  std::ostringstream graph_print_stream;
+  graph_print_stream << "{" << std::endl
+                     << "\tdepth: " << graph.depth() << "," << std::endl
+                     << "\tvertices: {amount: " << graph.vertices_count()
+                     << ", distribution: [";
+  for (auto depth = kDefaultDepth; depth <= graph.depth(); ++depth) {
+    if (depth != kDefaultDepth) {
+      graph_print_stream << ",";
+    }
+    graph_print_stream << " " << graph.get_depth_vertex_range(depth).size();
+  }
+
+  graph_print_stream << "]}," << std::endl
+                     << "\tedges: {amount: " << graph.edges_count()
+                     << ", distribution: {";
+  for (int color_index = 0; color_index < LargeGraph::kColorsCount;
+       ++color_index) {
+    const auto color = static_cast<EdgeColor>(color_index);
+    if (color != EdgeColor::Grey) {
+      graph_print_stream << ",";
+    }
+    graph_print_stream << " " << print_edge_color(color) << ": "
+                       << graph.edges_count(color);
+  }
+  graph_print_stream << "}}," << std::endl
+                     << "\tmapped: " << print_memory_size(graph.mapped_bytes())
+                     << std::endl
+                     << "}";
+  return graph_print_stream.str();
+}
+}  // namespace printing
+
+}  // namespace uni_course_cpp
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "interfaces/i_graph.hpp"
+#include "mapped_segment_array.hpp"
+
+namespace uni_course_cpp {
+
+using LargeVertexId = std::int64_t;
+using LargeEdgeId = std::int64_t;
+
+struct LargeVertexRange {
+  LargeVertexId begin = 0;
+  LargeVertexId end = 0;
+
+  LargeVertexId size() const { return end - begin; }
+};
+
+struct LargeEdgeRange {
+  LargeEdgeId begin = 0;
+  LargeEdgeId end = 0;
+
+  LargeEdgeId size() const { return end - begin; }
+};
+
+class LargeGraph {
+ public:
+  static constexpr int kColorsCount = 4;
+  static constexpr int kVersion = 1;
+
+  explicit LargeGraph(const std::string& directory_path);
+
+  LargeVertexRange add_depth(LargeVertexId vertices_count);
+  void add_out_edge(LargeVertexId to_vertex_id, EdgeColor color);
+  LargeVertexId finish_vertex();
+  void flush() const;
+
+  GraphDepth depth() const { return depth_begins_.size() - 1; }
+  LargeVertexId vertices_count() const { return depth_begins_.back(); }
+  LargeEdgeId edges_count() const { return edge_targets_.size(); }
+  LargeEdgeId edges_count(EdgeColor color) const {
+    return color_edges_counts_[static_cast<int>(color)];
+  }
+  LargeVertexId finished_vertices_count() const {
+    return edge_offsets_.size() - 1;
+  }
+
+  LargeVertexRange get_depth_vertex_range(GraphDepth depth) const;
+  GraphDepth get_vertex_depth(LargeVertexId id) const;
+  LargeEdgeRange get_out_edge_range(LargeVertexId id) const;
+  LargeVertexId get_edge_target(LargeEdgeId id) const {
+    return edge_targets_[id];
+  }
+  EdgeColor get_edge_color(LargeEdgeId id) const {
+    return static_cast<EdgeColor>(edge_colors_[id]);
+  }
+
+  const std::string& directory_path() const { return directory_path_; }
+  size_t mapped_bytes() const;
+
+ private:
+  std::string directory_path_;
+  std::vector<LargeVertexId> depth_begins_;
+  MappedSegmentArray<LargeEdgeId> edge_offsets_;
+  MappedSegmentArray<LargeVertexId> edge_targets_;
+  MappedSegmentArray<std::uint8_t> edge_colors_;
+  std::array<LargeEdgeId, kColorsCount> color_edges_counts_{};
+};
+
+namespace printing {
+std::string print_large_graph(const LargeGraph& graph);
+}  // namespace printing
+
+}  // namespace uni_course_cpp
@@ -0,0 +1,234 @@
+#include "large_graph_generator.hpp"
+#include <algorithm>
+#include <deque>
+#include <filesystem>
+#include <random>
+#include <utility>
+#include <vector>
+#include "parallel_for.hpp"
+
+namespace {
+
+using uni_course_cpp::EdgeColor;
+using uni_course_cpp::GraphDepth;
+using uni_course_cpp::LargeVertexId;
+
+static constexpr double kGreenEdgeProbability = 0.1;
+static constexpr double kRedEdgeProbability = 1.0 / 3.0;
+static constexpr GraphDepth kDefaultDepth = 1;
+static constexpr GraphDepth kYellowDepthStep = 1;
+static constexpr GraphDepth kRedDepthStep = 2;
+static constexpr int kResidentLayersCount = kRedDepthStep + 1;
+static constexpr int kBlockVerticesCount = 1 << 16;
+const std::string kScratchDirectoryName = "scratch/";
+
+std::mt19937_64& get_random_engine() {
+  thread_local std::mt19937_64 random_engine(std::random_device{}());
+  return random_engine;
+}
+
+bool check_probability(double probability) {
+  if (probability <= 0)
+    return false;
+  return std::bernoulli_distribution(probability)(get_random_engine());
+}
+
+LargeVertexId random_number_in_range(LargeVertexId size) {
+  return std::uniform_int_distribution<LargeVertexId>(0, size - 1)(
+      get_random_engine());
+}
+
+struct VertexEdgesBuffer {
+  std::vector<int> edges_counts;
+  std::vector<std::pair<LargeVertexId, EdgeColor>> edges;
+
+  void clear() {
+    edges_counts.clear();
+    edges.clear();
+  }
+};
+
+}  // namespace
+
+namespace uni_course_cpp {
+
+std::optional<LargeGraphGenerator::Layer>
+LargeGraphGenerator::generate_next_layer(
+    LargeGraph& graph,
+    Layer& layer,
+    const std::string& scratch_directory_path,
+    const GenerationGuard& generation_guard) const {
+  const auto depth_probability =
+      layer.depth < params_.depth()
+          ? (params_.depth() - layer.depth) /
+                static_cast<double>(params_.depth() - kDefaultDepth)
+          : 0.0;
+  auto children_counts = std::vector<int>(kBlockVerticesCount);
+  auto next_vertex_id = layer.vertex_range.end;
+
+  for (auto block_begin = layer.vertex_range.begin;
+       block_begin < layer.vertex_range.end;
+       block_begin += kBlockVerticesCount) {
+    generation_guard.throw_if_stopped(graph.vertices_count(),
+                                      graph.edges_count());
+    const int block_size = std::min<LargeVertexId>(
+        kBlockVerticesCount, layer.vertex_range.end - block_begin);
+    parallel_for(0, block_size, threads_count_,
+                 [this, &children_counts, depth_probability](
+                     int, int chunk_begin, int chunk_end) {
+                   auto distribution = std::binomial_distribution<int>(
+                       params_.new_vertices_count(), depth_probability);
+                   for (int i = chunk_begin; i < chunk_end; ++i) {
+                     children_counts[i] = distribution(get_random_engine());
+                   }
+                 });
+    for (int i = 0; i < block_size; ++i) {
+      layer.child_begins.push_back(next_vertex_id);
+      next_vertex_id += children_counts[i];
+    }
+  }
+  layer.child_begins.push_back(next_vertex_id);
+
+  const auto next_layer_vertices_count =
+      next_vertex_id - layer.vertex_range.end;
+  if (next_layer_vertices_count == 0)
+    return std::nullopt;
+
+  const auto next_depth = layer.depth + 1;
+  return Layer{next_depth, graph.add_depth(next_layer_vertices_count),
+               MappedSegmentArray<LargeVertexId>(
+                   scratch_directory_path + "child_begins_" +
+                   std::to_string(next_depth))};
+}
+
+void LargeGraphGenerator::generate_layer_edges(
+    LargeGraph& graph,
+    const Layer& layer,
+    const GenerationGuard& generation_guard) const {
+  const auto yellow_vertex_range =
+      graph.get_depth_vertex_range(layer.depth + kYellowDepthStep);
+  const auto red_vertex_range =
+      graph.get_depth_vertex_range(layer.depth + kRedDepthStep);
+  const auto yellow_depths_count =
+      params_.depth() - kYellowDepthStep - kDefaultDepth;
+  const auto yellow_probability =
+      yellow_depths_count > 0
+          ? (layer.depth - kDefaultDepth) /
+                static_cast<double>(yellow_depths_count)
+          : 0.0;
+  auto buffers = std::vector<VertexEdgesBuffer>(threads_count_);
+
+  for (auto block_begin = layer.vertex_range.begin;
+       block_begin < layer.vertex_range.end;
+       block_begin += kBlockVerticesCount) {
+    generation_guard.throw_if_stopped(graph.vertices_count(),
+                                      graph.edges_count());
+    const int block_size = std::min<LargeVertexId>(
+        kBlockVerticesCount, layer.vertex_range.end - block_begin);
+    parallel_for(
+        0, block_size, threads_count_,
+        [&layer, &buffers, &yellow_vertex_range, &red_vertex_range,
+         yellow_probability, block_begin](int thread_index, int chunk_begin,
+                                          int chunk_end) {
+          auto& buffer = buffers[thread_index];
+          buffer.clear();
+          for (int i = chunk_begin; i < chunk_end; ++i) {
+            const auto vertex_id = block_begin + i;
+            const auto layer_index = vertex_id - layer.vertex_range.begin;
+            const auto child_begin = layer.child_begins[layer_index];
+            const auto child_end = layer.child_begins[layer_index + 1];
+            const auto edges_count = buffer.edges.size();
+
+            for (auto child_id = child_begin; child_id < child_end;
+                 ++child_id) {
+              buffer.edges.emplace_back(child_id, EdgeColor::Grey);
+            }
+            if (check_probability(kGreenEdgeProbability)) {
+              buffer.edges.emplace_back(vertex_id, EdgeColor::Green);
+            }
+            const auto unconnected_vertices_count =
+                yellow_vertex_range.size() - (child_end - child_begin);
+            if (unconnected_vertices_count > 0 &&
+                check_probability(yellow_probability)) {
+              auto to_vertex_id =
+                  yellow_vertex_range.begin +
+                  random_number_in_range(unconnected_vertices_count);
+              if (to_vertex_id >= child_begin) {
+                to_vertex_id += child_end - child_begin;
+              }
+              buffer.edges.emplace_back(to_vertex_id, EdgeColor::Yellow);
+            }
+            if (red_vertex_range.size() > 0 &&
+                check_probability(kRedEdgeProbability)) {
+              buffer.edges.emplace_back(
+                  red_vertex_range.begin +
+                      random_number_in_range(red_vertex_range.size()),
+                  EdgeColor::Red);
+            }
+            buffer.edges_counts.push_back(buffer.edges.size() - edges_count);
+          }
+        });
+
+    for (const auto& buffer : buffers) {
+      auto edge_it = buffer.edges.cbegin();
+      for (const auto edges_count : buffer.edges_counts) {
+        for (int i = 0; i < edges_count; ++i, ++edge_it) {
+          graph.add_out_edge(edge_it->first, edge_it->second);
+        }
+        graph.finish_vertex();
+      }
+    }
+    for (auto& buffer : buffers) {
+      buffer.clear();
+    }
+  }
+}
+
+LargeGraph LargeGraphGenerator::generate(
+    const std::string& directory_path,
+    const GenerationGuard& generation_guard) const {
+  auto graph = LargeGraph(directory_path);
+  if (params_.depth() == 0) {
+    graph.flush();
+    return graph;
+  }
+
+  const auto scratch_directory_path =
+      graph.directory_path() + kScratchDirectoryName;
+  std::filesystem::create_directories(scratch_directory_path);
+  try {
+    auto layers = std::deque<Layer>();
+    layers.push_back(Layer{kDefaultDepth, graph.add_depth(1),
+                           MappedSegmentArray<LargeVertexId>(
+                               scratch_directory_path + "child_begins_" +
+                               std::to_string(kDefaultDepth))});
+    bool is_last_layer_generated = false;
+    while (!layers.empty()) {
+      if (!is_last_layer_generated) {
+        auto next_layer = generate_next_layer(
+            graph, layers.back(), scratch_directory_path, generation_guard);
+        if (next_layer) {
+          layers.push_back(std::move(*next_layer));
+        } else {
+          is_last_layer_generated = true;
+        }
+      }
+
+      if (is_last_layer_generated ||
+          static_cast<int>(layers.size()) == kResidentLayersCount) {
+        generate_layer_edges(graph, layers.front(), generation_guard);
+        layers.front().child_begins.remove_files();
+        layers.pop_front();
+      }
+    }
+  } catch (...) {
+    std::filesystem::remove_all(scratch_directory_path);
+    throw;
+  }
+  std::filesystem::remove_all(scratch_directory_path);
+
+  graph.flush();
+  return graph;
+}
+
+}  // namespace uni_course_cpp
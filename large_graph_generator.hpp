@@ -0,0 +1,43 @@
+#pragma once
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include "generation_guard.hpp"
+#include "graph_generator.hpp"
+#include "large_graph.hpp"
+#include "mapped_segment_array.hpp"
+
+namespace uni_course_cpp {
+
+class LargeGraphGenerator {
+ public:
+  LargeGraphGenerator(GraphGenerator::Params&& params, int threads_count)
+      : params_(std::move(params)),
+        threads_count_(std::max(1, threads_count)) {}
+
+  LargeGraph generate(
+      const std::string& directory_path,
+      const GenerationGuard& generation_guard = GenerationGuard()) const;
+
+ private:
+  struct Layer {
+    GraphDepth depth = 0;
+    LargeVertexRange vertex_range;
+    MappedSegmentArray<LargeVertexId> child_begins;
+  };
+
+  std::optional<Layer> generate_next_layer(
+      LargeGraph& graph,
+      Layer& layer,
+      const std::string& scratch_directory_path,
+      const GenerationGuard& generation_guard) const;
+  void generate_layer_edges(LargeGraph& graph,
+                            const Layer& layer,
+                            const GenerationGuard& generation_guard) const;
+
+  GraphGenerator::Params params_;
+  int threads_count_ = 1;
+};
+
+}  // namespace uni_course_cpp
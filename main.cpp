@@ -1,17 +1,34 @@
+#include <unistd.h>
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <string>
+#include "battle_simulator.hpp"
 #include "config.hpp"
+#include "edge_encounters.hpp"
+#include "fighter.hpp"
+#include "generation_guard.hpp"
 #include "graph.hpp"
+#include "graph_replay_cache.hpp"
+#include "graph_compression.hpp"
 #include "graph_generation_controller.hpp"
 #include "graph_generator.hpp"
 #include "graph_json_printer.hpp"
 #include "graph_printer.hpp"
+#include "graph_traversal.hpp"
+#include "graph_validator.hpp"
 #include "interfaces/i_graph.hpp"
+#include "knight_optimizer.hpp"
+#include "large_graph_generator.hpp"
 #include "logger.hpp"
+#include "memory_tracker.hpp"
+#include "metrics.hpp"
+#include "shared_graph.hpp"
+#include "shared_graph_queue.hpp"
 
 static constexpr int kMinValue = 0;
+static constexpr uni_course_cpp::GraphDepth kDefaultDepth = 1;
 
 void prepare_temp_directory() {
   std::filesystem::create_directory(uni_course_cpp::config::kTempDirectoryPath);
@@ -31,12 +48,47 @@ int handle_input_value(std::string message) {
   return input_value;
 }
 
+static const std::string kCompressedFileExtension = ".gz";
+
 void write_to_file(const std::string& graph_string,
-                   const std::string& file_name) {
+                   const std::string& file_name,
+                   int threads_count) {
+  if (uni_course_cpp::config::kCompressGraphOutput) {
+    const auto compressed_graph_string =
+        uni_course_cpp::compression::compress(graph_string, threads_count);
+    std::ofstream output_file(uni_course_cpp::config::kTempDirectoryPath +
+                                  file_name + kCompressedFileExtension,
+                              std::ios::binary);
+    output_file << compressed_graph_string;
+    output_file.close();
+    uni_course_cpp::Metrics::get_metrics().add(
+        uni_course_cpp::Counter::BytesWritten, compressed_graph_string.size());
+    return;
+  }
+
   std::ofstream output_file(uni_course_cpp::config::kTempDirectoryPath +
                             file_name);
   output_file << graph_string;
   output_file.close();
+  uni_course_cpp::Metrics::get_metrics().add(
+      uni_course_cpp::Counter::BytesWritten, graph_string.size());
+}
+
+bool write_to_shared_memory(const uni_course_cpp::IGraph& graph,
+                            int index,
+                            uni_course_cpp::SharedGraphQueue& queue) {
+  const auto shm_name = uni_course_cpp::config::kSharedGraphNamePrefix +
+                        std::to_string(getpid()) + "_" +
+                        std::to_string(index);
+  auto descriptor = uni_course_cpp::SharedGraphDescriptor(index, 0, shm_name);
+  descriptor.size_bytes = uni_course_cpp::write_shared_graph(graph, shm_name);
+  if (!queue.try_push(descriptor)) {
+    uni_course_cpp::unlink_shared_graph(shm_name);
+    return false;
+  }
+  uni_course_cpp::Metrics::get_metrics().add(
+      uni_course_cpp::Counter::BytesWritten, descriptor.size_bytes);
+  return true;
 }
 
 std::string generation_started_string(int index) {
@@ -45,43 +97,324 @@ std::string generation_started_string(int index) {
   return output.str();
 }
 
-std::string generation_finished_string(int index,
-                                       const std::string& graph_description) {
+std::string generation_finished_string(
+    int index,
+    const std::string& graph_description,
+    const uni_course_cpp::GraphMemoryUsage& graph_memory_usage) {
+  std::stringstream output;
+  output << "Graph " << index << ", Generation Finished " << graph_description
+         << ", memory: "
+         << uni_course_cpp::printing::print_graph_memory_usage(
+                graph_memory_usage)
+         << ", process: "
+         << uni_course_cpp::printing::print_process_memory_usage(
+                uni_course_cpp::get_process_memory_usage());
+  return output.str();
+}
+
+std::string shared_memory_queue_full_string(int index) {
   std::stringstream output;
-  output << "Graph " << index << ", Generation Finished " << graph_description;
+  output << "Graph " << index << ", Shared Memory Queue Is Full";
   return output.str();
 }
 
+std::string shared_memory_failed_string(int index, const std::string& error) {
+  std::stringstream output;
+  output << "Graph " << index << ", Shared Memory Write Failed: " << error;
+  return output.str();
+}
+
+std::string stale_shared_graphs_string(int unlinked_count) {
+  std::stringstream output;
+  output << "Shared Memory, Reclaimed Stale Graphs: " << unlinked_count;
+  return output.str();
+}
+
+std::string generation_failed_string(int index, const std::string& error) {
+  std::stringstream output;
+  output << "Graph " << index << ", Generation Failed: " << error;
+  return output.str();
+}
+
+uni_course_cpp::GenerationBudget get_job_budget() {
+  auto job_budget = uni_course_cpp::GenerationBudget();
+  if (uni_course_cpp::config::kJobTimeLimitMs > 0) {
+    job_budget.time_limit =
+        std::chrono::milliseconds(uni_course_cpp::config::kJobTimeLimitMs);
+  }
+  if (uni_course_cpp::config::kJobMaxVerticesCount > 0) {
+    job_budget.max_vertices_count =
+        uni_course_cpp::config::kJobMaxVerticesCount;
+  }
+  if (uni_course_cpp::config::kJobMaxEdgesCount > 0) {
+    job_budget.max_edges_count = uni_course_cpp::config::kJobMaxEdgesCount;
+  }
+  return job_budget;
+}
+
+std::string run_summary_string(int graphs_count, size_t graphs_memory_bytes) {
+  std::stringstream output;
+  output << "Run Summary, graphs: " << graphs_count << ", graphs memory: "
+         << uni_course_cpp::printing::print_memory_size(graphs_memory_bytes);
+  if (uni_course_cpp::config::kHeapTrackingEnabled) {
+    output << ", heap: "
+           << uni_course_cpp::printing::print_heap_memory_usage(
+                  uni_course_cpp::get_heap_memory_usage());
+  }
+  output << ", process: "
+         << uni_course_cpp::printing::print_process_memory_usage(
+                uni_course_cpp::get_process_memory_usage());
+  return output.str();
+}
+
+std::string validation_string(int index,
+                              const uni_course_cpp::ValidationReport& report) {
+  std::stringstream output;
+  output << "Graph " << index << ", "
+         << uni_course_cpp::printing::print_validation_report(report);
+  return output.str();
+}
+
+std::string edge_risks_string(int index,
+                              const uni_course_cpp::EdgeRisks& edge_risks) {
+  float max_death_probability = 0;
+  float total_expected_damage = 0;
+  for (const auto& [edge_id, edge_risk] : edge_risks) {
+    max_death_probability =
+        std::max(max_death_probability, edge_risk.death_probability());
+    total_expected_damage += edge_risk.expected_damage();
+  }
+  std::stringstream output;
+  output << "Graph " << index << ", Edge Risks: {encounters: "
+         << edge_risks.size()
+         << ", max_death_probability: " << max_death_probability
+         << ", total_expected_damage: " << total_expected_damage << "}";
+  return output.str();
+}
+
+std::string knight_optimization_string(
+    int index,
+    const uni_course_cpp::KnightOptimizer::Result& result) {
+  std::stringstream output;
+  output << "Graph " << index << ", Knight Optimization Finished, stats: "
+         << uni_course_cpp::printing::print_fighter_stats(result.knight_stats)
+         << ", route survival: " << result.route_survival_probability
+         << ", route damage: " << result.route_expected_damage
+         << ", cache hits/misses: " << result.cache_hits_count << "/"
+         << result.cache_misses_count << ", generation times ms: [";
+  for (auto it = result.generation_durations_ms.cbegin();
+       it != result.generation_durations_ms.cend(); ++it) {
+    if (it != result.generation_durations_ms.cbegin()) {
+      output << ",";
+    }
+    output << " " << *it;
+  }
+  output << "]";
+  return output.str();
+}
+
+std::string hop_statistics_string(int index,
+                                  const uni_course_cpp::IGraph& graph,
+                                  const uni_course_cpp::BfsResult& bfs_result) {
+  std::stringstream output;
+  output << "Graph " << index
+         << ", Reachable Vertices: " << bfs_result.reachable_count << "/"
+         << graph.vertices_count()
+         << ", Max Hops: " << bfs_result.max_distance()
+         << ", Hops Distribution: [";
+  for (auto it = bfs_result.level_sizes.cbegin();
+       it != bfs_result.level_sizes.cend(); ++it) {
+    if (it != bfs_result.level_sizes.cbegin()) {
+      output << ",";
+    }
+    output << " " << *it;
+  }
+  output << "]";
+  return output.str();
+}
+
+uni_course_cpp::BfsResult calculate_hop_statistics(
+    const uni_course_cpp::IGraph& graph,
+    int threads_count) {
+  if (graph.vertices_count() == 0)
+    return uni_course_cpp::BfsResult();
+  const auto root_vertex_id =
+      *graph.get_depth_vertex_ids(kDefaultDepth).cbegin();
+  return uni_course_cpp::breadth_first_search(
+      graph, root_vertex_id,
+      {uni_course_cpp::EdgeColor::Grey, uni_course_cpp::EdgeColor::Yellow,
+       uni_course_cpp::EdgeColor::Red},
+      threads_count);
+}
+
+uni_course_cpp::GraphGenerator::Params get_graph_params(
+    const uni_course_cpp::GraphGenerator::Params& params,
+    int index) {
+  if (!uni_course_cpp::config::kHeterogeneousBatchEnabled)
+    return params;
+  return uni_course_cpp::GraphGenerator::Params(
+      params.depth() +
+          index % uni_course_cpp::config::kHeterogeneousBatchDepthsCount,
+      params.new_vertices_count(), params.renumber_vertices_by_depth());
+}
+
 std::vector<std::unique_ptr<uni_course_cpp::IGraph>> generate_graphs(
     uni_course_cpp::GraphGenerator::Params&& params,
     int graphs_count,
     int threads_count) {
+  auto graph_replay_cache = std::shared_ptr<uni_course_cpp::GraphReplayCache>();
+  if (uni_course_cpp::config::kGraphReplayCacheEnabled) {
+    graph_replay_cache = std::make_shared<uni_course_cpp::GraphReplayCache>(
+        uni_course_cpp::config::kGraphReplayCacheDirectoryPath,
+        uni_course_cpp::config::kGraphReplayCacheMaxSizeBytes);
+  }
+  using WorkerPlacement =
+      uni_course_cpp::GraphGenerationController::WorkerPlacement;
+  const auto worker_placement = uni_course_cpp::config::kPinWorkersToNumaNodes
+                                    ? WorkerPlacement::NumaNode
+                                    : WorkerPlacement::Floating;
+  auto graphs_params = std::vector<uni_course_cpp::GraphGenerator::Params>();
+  graphs_params.reserve(graphs_count);
+  for (int i = 0; i < graphs_count; ++i) {
+    graphs_params.push_back(get_graph_params(params, i));
+  }
   auto generation_controller = uni_course_cpp::GraphGenerationController(
-      threads_count, graphs_count, std::move(params));
+      threads_count, std::move(graphs_params), graph_replay_cache,
+      worker_placement);
+  generation_controller.set_job_budget(get_job_budget());
 
   auto& logger = uni_course_cpp::Logger::get_logger();
 
+  auto shared_graph_queue = std::unique_ptr<uni_course_cpp::SharedGraphQueue>();
+  auto shared_graph_flags = std::vector<char>(graphs_count, 0);
+  if (uni_course_cpp::config::kSharedMemoryOutputEnabled) {
+    const auto unlinked_count = uni_course_cpp::unlink_stale_shared_graphs(
+        uni_course_cpp::config::kSharedGraphNamePrefix);
+    if (unlinked_count > 0) {
+      logger.log(stale_shared_graphs_string(unlinked_count));
+    }
+    uni_course_cpp::SharedGraphQueue::unlink(
+        uni_course_cpp::config::kSharedGraphQueueName);
+    shared_graph_queue = std::make_unique<uni_course_cpp::SharedGraphQueue>(
+        uni_course_cpp::config::kSharedGraphQueueName,
+        uni_course_cpp::config::kSharedGraphQueueCapacity);
+    generation_controller.set_graph_ready_callback(
+        [&logger, &shared_graph_queue, &shared_graph_flags](
+            int index, const uni_course_cpp::IGraph& graph) {
+          try {
+            shared_graph_flags[index] =
+                write_to_shared_memory(graph, index, *shared_graph_queue);
+            if (!shared_graph_flags[index]) {
+              logger.log(shared_memory_queue_full_string(index));
+            }
+          } catch (const std::exception& error) {
+            logger.log(shared_memory_failed_string(index, error.what()));
+          }
+        });
+  }
+
   auto graphs =
       std::vector<std::unique_ptr<uni_course_cpp::IGraph>>(graphs_count);
+  size_t graphs_memory_bytes = 0;
+  uni_course_cpp::reset_heap_peak();
+
+  auto metrics_exporter = uni_course_cpp::MetricsExporter(
+      uni_course_cpp::config::kMetricsFilePath,
+      std::chrono::milliseconds(
+          uni_course_cpp::config::kMetricsExportPeriodMs));
+  if (uni_course_cpp::config::kMetricsEnabled) {
+    metrics_exporter.start();
+  }
 
   generation_controller.generate(
       [&logger](int index) { logger.log(generation_started_string(index)); },
-      [&logger, &graphs](int index,
-                         std::unique_ptr<uni_course_cpp::IGraph> graph) {
+      [&logger, &graphs, &graphs_memory_bytes, &shared_graph_flags,
+       threads_count](int index,
+                      std::unique_ptr<uni_course_cpp::IGraph> graph) {
+        const bool is_graph_shared = shared_graph_flags[index];
         const auto graph_description =
             uni_course_cpp::printing::print_graph(*graph);
-        logger.log(generation_finished_string(index, graph_description));
+        const auto graph_memory_usage = graph->memory_usage();
+        graphs_memory_bytes += graph_memory_usage.total_bytes();
+        logger.log(generation_finished_string(index, graph_description,
+                                              graph_memory_usage));
 
-        const auto graph_json =
-            uni_course_cpp::printing::json::print_graph(*graph);
-        write_to_file(graph_json, "graph_" + std::to_string(index) + ".json");
+        if (!is_graph_shared) {
+          const auto graph_json =
+              uni_course_cpp::printing::json::print_graph(*graph);
+          write_to_file(graph_json,
+                        "graph_" + std::to_string(index) + ".json",
+                        threads_count);
+        }
 
-        graphs.push_back(std::move(graph));
+        graphs[index] = std::move(graph);
+      },
+      [&logger](int index, const std::string& error) {
+        logger.log(generation_failed_string(index, error));
       });
 
+  const auto battle_simulator =
+      uni_course_cpp::BattleSimulator(uni_course_cpp::BattleSimulator::Params(
+          uni_course_cpp::config::kBattleFightsCount, threads_count));
+  const auto battle_table = battle_simulator.simulate_all(
+      uni_course_cpp::get_default_knight_stats());
+  auto knight_optimizer =
+      uni_course_cpp::KnightOptimizer(uni_course_cpp::KnightOptimizer::Params(
+          uni_course_cpp::config::kKnightOptimizationGenerationsCount,
+          uni_course_cpp::config::kKnightOptimizationPopulationSize,
+          uni_course_cpp::config::kKnightOptimizationFightsCount,
+          threads_count));
+  for (int index = 0; index < graphs_count; ++index) {
+    const auto& graph = graphs[index];
+    if (!graph)
+      continue;
+    const auto validation_report =
+        uni_course_cpp::validate_graph(*graph, threads_count);
+    logger.log(validation_string(index, validation_report));
+
+    const auto edge_encounters =
+        uni_course_cpp::generate_edge_encounters(*graph);
+    const auto edge_risks = uni_course_cpp::calculate_edge_risks(
+        edge_encounters, *graph, battle_table);
+    logger.log(edge_risks_string(index, edge_risks));
+
+    if (uni_course_cpp::config::kKnightOptimizationEnabled) {
+      const auto optimization_result =
+          knight_optimizer.optimize(*graph, edge_encounters);
+      logger.log(knight_optimization_string(index, optimization_result));
+    }
+
+    const auto bfs_result = calculate_hop_statistics(*graph, threads_count);
+    logger.log(hop_statistics_string(index, *graph, bfs_result));
+  }
+
+  metrics_exporter.stop();
+  logger.log(run_summary_string(graphs_count, graphs_memory_bytes));
+
   return graphs;
 }
 
+void generate_large_graphs(uni_course_cpp::GraphGenerator::Params&& params,
+                           int graphs_count,
+                           int threads_count) {
+  auto& logger = uni_course_cpp::Logger::get_logger();
+  const auto large_graph_generator =
+      uni_course_cpp::LargeGraphGenerator(std::move(params), threads_count);
+  for (int i = 0; i < graphs_count; ++i) {
+    logger.log(generation_started_string(i));
+    const auto graph = large_graph_generator.generate(
+        uni_course_cpp::config::kLargeGraphDirectoryPath + "graph_" +
+        std::to_string(i));
+    std::stringstream output;
+    output << "Graph " << i << ", Generation Finished "
+           << uni_course_cpp::printing::print_large_graph(graph)
+           << ", process: "
+           << uni_course_cpp::printing::print_process_memory_usage(
+                  uni_course_cpp::get_process_memory_usage());
+    logger.log(output.str());
+  }
+}
+
 int main() {
   const int depth = handle_input_value("graph depth");
   const int new_vertices_count = handle_input_value("new_vertices_count");
@@ -89,8 +422,13 @@ int main() {
   const int threads_count = handle_input_value("threads count");
   prepare_temp_directory();
 
-  auto params =
-      uni_course_cpp::GraphGenerator::Params(depth, new_vertices_count);
+  auto params = uni_course_cpp::GraphGenerator::Params(
+      depth, new_vertices_count,
+      uni_course_cpp::config::kRenumberVerticesByDepth);
+  if (uni_course_cpp::config::kLargeGraphModeEnabled) {
+    generate_large_graphs(std::move(params), graphs_count, threads_count);
+    return 0;
+  }
   const auto graphs =
       generate_graphs(std::move(params), graphs_count, threads_count);
 
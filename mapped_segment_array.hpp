@@ -0,0 +1,127 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace uni_course_cpp {
+
+template <typename T>
+class MappedSegmentArray {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "MappedSegmentArray requires trivially copyable elements");
+
+ public:
+  static constexpr size_t kDefaultSegmentBytes = 64 * 1024 * 1024;
+
+  explicit MappedSegmentArray(
+      std::string file_path_prefix,
+      size_t segment_size = kDefaultSegmentBytes / sizeof(T))
+      : file_path_prefix_(std::move(file_path_prefix)),
+        segment_size_(segment_size) {}
+  MappedSegmentArray(const MappedSegmentArray&) = delete;
+  MappedSegmentArray& operator=(const MappedSegmentArray&) = delete;
+  MappedSegmentArray(MappedSegmentArray&& other) noexcept
+      : file_path_prefix_(std::move(other.file_path_prefix_)),
+        segment_size_(other.segment_size_),
+        size_(std::exchange(other.size_, 0)),
+        segments_(std::exchange(other.segments_, {})) {}
+  ~MappedSegmentArray() { unmap_segments(); }
+
+  void push_back(const T& value) {
+    if (size_ == segments_.size() * segment_size_) {
+      add_segment();
+    }
+    segments_.back()[size_ % segment_size_] = value;
+    ++size_;
+  }
+
+  T& operator[](size_t index) {
+    return segments_[index / segment_size_][index % segment_size_];
+  }
+  const T& operator[](size_t index) const {
+    return segments_[index / segment_size_][index % segment_size_];
+  }
+
+  size_t size() const { return size_; }
+  size_t mapped_bytes() const {
+    return segments_.size() * segment_size_ * sizeof(T);
+  }
+  const std::string& file_path_prefix() const { return file_path_prefix_; }
+
+  void flush() const {
+    for (const auto segment : segments_) {
+      msync(segment, segment_size_ * sizeof(T), MS_SYNC);
+    }
+  }
+
+  void remove_files() {
+    const auto segments_count = segments_.size();
+    unmap_segments();
+    for (size_t i = 0; i < segments_count; ++i) {
+      std::filesystem::remove(get_segment_file_path(i));
+    }
+    size_ = 0;
+  }
+
+ private:
+  std::string get_segment_file_path(size_t segment_index) const {
+    std::ostringstream file_path;
+    file_path << file_path_prefix_ << "." << std::setw(6) << std::setfill('0')
+              << segment_index << ".seg";
+    return file_path.str();
+  }
+
+  void add_segment() {
+    if (!segments_.empty()) {
+      msync(segments_.back(), segment_size_ * sizeof(T), MS_ASYNC);
+    }
+
+    const auto file_path = get_segment_file_path(segments_.size());
+    const auto segment_bytes = segment_size_ * sizeof(T);
+    const int file_descriptor =
+        open(file_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file_descriptor < 0) {
+      throw std::runtime_error("Failed to open segment file " + file_path +
+                               ": " + std::strerror(errno));
+    }
+    if (ftruncate(file_descriptor, segment_bytes) != 0) {
+      const auto error = std::string(std::strerror(errno));
+      close(file_descriptor);
+      throw std::runtime_error("Failed to resize segment file " + file_path +
+                               ": " + error);
+    }
+    void* const segment = mmap(nullptr, segment_bytes, PROT_READ | PROT_WRITE,
+                               MAP_SHARED, file_descriptor, 0);
+    close(file_descriptor);
+    if (segment == MAP_FAILED) {
+      throw std::runtime_error("Failed to map segment file " + file_path +
+                               ": " + std::strerror(errno));
+    }
+    segments_.push_back(static_cast<T*>(segment));
+  }
+
+  void unmap_segments() {
+    for (const auto segment : segments_) {
+      munmap(segment, segment_size_ * sizeof(T));
+    }
+    segments_.clear();
+  }
+
+  std::string file_path_prefix_;
+  size_t segment_size_ = 0;
+  size_t size_ = 0;
+  std::vector<T*> segments_;
+};
+
+}  // namespace uni_course_cpp
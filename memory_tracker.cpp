@@ -0,0 +1,293 @@
+#include "memory_tracker.hpp"
+#include <malloc.h>
+#include <sys/resource.h>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include "config.hpp"
+
+namespace {
+
+static constexpr size_t kBytesInKilobyte = 1024;
+static constexpr size_t kBytesInMegabyte = 1024 * kBytesInKilobyte;
+const std::string kProcessStatusPath = "/proc/self/status";
+const std::string kRssField = "VmRSS:";
+const std::string kPeakRssField = "VmHWM:";
+
+static constexpr int kThreadSlotsCount = 256;
+static constexpr size_t kCacheLineSize = 64;
+static constexpr long long kPeakSamplingPeriod = 4096;
+
+// Bytes are signed per slot: a block may be freed on another thread.
+struct alignas(kCacheLineSize) ThreadSlot {
+  std::atomic<long long> allocated_bytes = 0;
+  std::atomic<long long> allocations_count = 0;
+};
+
+std::array<ThreadSlot, kThreadSlotsCount> thread_slots;
+std::atomic<int> next_thread_slot_index = 0;
+std::atomic<size_t> peak_allocated_bytes = 0;
+
+ThreadSlot& get_thread_slot() {
+  thread_local const int thread_slot_index =
+      next_thread_slot_index.fetch_add(1, std::memory_order_relaxed) %
+      kThreadSlotsCount;
+  return thread_slots[thread_slot_index];
+}
+
+size_t sum_allocated_bytes() {
+  long long bytes = 0;
+  for (const auto& slot : thread_slots) {
+    bytes += slot.allocated_bytes.load(std::memory_order_relaxed);
+  }
+  return bytes > 0 ? bytes : 0;
+}
+
+size_t update_peak_allocated_bytes() {
+  const size_t current_bytes = sum_allocated_bytes();
+  size_t peak_bytes = peak_allocated_bytes.load(std::memory_order_relaxed);
+  while (current_bytes > peak_bytes &&
+         !peak_allocated_bytes.compare_exchange_weak(
+             peak_bytes, current_bytes, std::memory_order_relaxed)) {
+  }
+  return current_bytes;
+}
+
+void on_allocate(void* pointer) {
+  auto& slot = get_thread_slot();
+  slot.allocated_bytes.fetch_add(malloc_usable_size(pointer),
+                                 std::memory_order_relaxed);
+  const auto allocations_count =
+      slot.allocations_count.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (allocations_count % kPeakSamplingPeriod == 0) {
+    update_peak_allocated_bytes();
+  }
+}
+
+void on_deallocate(void* pointer) {
+  get_thread_slot().allocated_bytes.fetch_sub(malloc_usable_size(pointer),
+                                              std::memory_order_relaxed);
+}
+
+void* allocate(size_t size) {
+  void* const pointer = std::malloc(size == 0 ? 1 : size);
+  if (uni_course_cpp::config::kHeapTrackingEnabled && pointer) {
+    on_allocate(pointer);
+  }
+  return pointer;
+}
+
+void* allocate_aligned(size_t size, std::align_val_t alignment) {
+  const auto alignment_bytes = static_cast<size_t>(alignment);
+  const auto aligned_size =
+      (size + alignment_bytes - 1) / alignment_bytes * alignment_bytes;
+  void* const pointer = std::aligned_alloc(
+      alignment_bytes, aligned_size == 0 ? alignment_bytes : aligned_size);
+  if (uni_course_cpp::config::kHeapTrackingEnabled && pointer) {
+    on_allocate(pointer);
+  }
+  return pointer;
+}
+
+void deallocate(void* pointer) {
+  if (!pointer)
+    return;
+  if (uni_course_cpp::config::kHeapTrackingEnabled) {
+    on_deallocate(pointer);
+  }
+  std::free(pointer);
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+  void* const pointer = allocate(size);
+  if (!pointer) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+  deallocate(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  deallocate(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+  deallocate(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+  deallocate(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+  deallocate(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+  deallocate(pointer);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+  void* const pointer = allocate_aligned(size, alignment);
+  if (!pointer) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+  return operator new(size, alignment);
+}
+
+void* operator new(size_t size,
+                   std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+  return allocate_aligned(size, alignment);
+}
+
+void* operator new[](size_t size,
+                     std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+  return allocate_aligned(size, alignment);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+  deallocate(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+  deallocate(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept {
+  deallocate(pointer);
+}
+
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept {
+  deallocate(pointer);
+}
+
+void operator delete(void* pointer,
+                     std::align_val_t,
+                     const std::nothrow_t&) noexcept {
+  deallocate(pointer);
+}
+
+void operator delete[](void* pointer,
+                       std::align_val_t,
+                       const std::nothrow_t&) noexcept {
+  deallocate(pointer);
+}
+
+namespace uni_course_cpp {
+
+HeapMemoryUsage get_heap_memory_usage() {
+  HeapMemoryUsage usage;
+  usage.allocated_bytes = update_peak_allocated_bytes();
+  usage.peak_allocated_bytes =
+      peak_allocated_bytes.load(std::memory_order_relaxed);
+  for (const auto& slot : thread_slots) {
+    usage.allocations_count +=
+        slot.allocations_count.load(std::memory_order_relaxed);
+  }
+  return usage;
+}
+
+void reset_heap_peak() {
+  peak_allocated_bytes.store(sum_allocated_bytes(), std::memory_order_relaxed);
+}
+
+ProcessMemoryUsage get_process_memory_usage() {
+  ProcessMemoryUsage usage;
+  std::ifstream status_file(kProcessStatusPath);
+  std::string field;
+  while (status_file >> field) {
+    size_t kilobytes = 0;
+    if (field == kRssField && status_file >> kilobytes) {
+      usage.rss_bytes = kilobytes * kBytesInKilobyte;
+    } else if (field == kPeakRssField && status_file >> kilobytes) {
+      usage.peak_rss_bytes = kilobytes * kBytesInKilobyte;
+    }
+  }
+
+  if (usage.peak_rss_bytes == 0) {
+    rusage resource_usage;
+    if (getrusage(RUSAGE_SELF, &resource_usage) == 0) {
+      usage.peak_rss_bytes = resource_usage.ru_maxrss * kBytesInKilobyte;
+    }
+  }
+  return usage;
+}
+
+namespace printing {
+
+std::string print_memory_size(size_t bytes) {
+  std::ostringstream size_print_stream;
+  if (bytes >= kBytesInMegabyte) {
+    size_print_stream << static_cast<double>(bytes) / kBytesInMegabyte
+                      << " MB";
+  } else if (bytes >= kBytesInKilobyte) {
+    size_print_stream << static_cast<double>(bytes) / kBytesInKilobyte
+                      << " KB";
+  } else {
+    size_print_stream << bytes << " B";
+  }
+  return size_print_stream.str();
+}
+
+std::string print_graph_memory_usage(const GraphMemoryUsage& usage) {
+  std::ostringstream usage_print_stream;
+  usage_print_stream << "{total: " << print_memory_size(usage.total_bytes())
+                     << ", edges: " << print_memory_size(usage.edges_bytes)
+                     << ", vertices: "
+                     << print_memory_size(usage.vertices_bytes)
+                     << ", adjacency_list: "
+                     << print_memory_size(usage.adjacency_list_bytes)
+                     << ", depth_vertex_ids: "
+                     << print_memory_size(usage.depth_vertex_ids_bytes)
+                     << ", vertex_depths: "
+                     << print_memory_size(usage.vertex_depths_bytes) << "}";
+  return usage_print_stream.str();
+}
+
+std::string print_heap_memory_usage(const HeapMemoryUsage& usage) {
+  std::ostringstream usage_print_stream;
+  usage_print_stream << "{allocated: "
+                     << print_memory_size(usage.allocated_bytes)
+                     << ", peak: "
+                     << print_memory_size(usage.peak_allocated_bytes)
+                     << ", allocations: " << usage.allocations_count << "}";
+  return usage_print_stream.str();
+}
+
+std::string print_process_memory_usage(const ProcessMemoryUsage& usage) {
+  std::ostringstream usage_print_stream;
+  usage_print_stream << "{rss: " << print_memory_size(usage.rss_bytes)
+                     << ", peak_rss: "
+                     << print_memory_size(usage.peak_rss_bytes)
+                     << "}";
+  return usage_print_stream.str();
+}
+
+}  // namespace printing
+}  // namespace uni_course_cpp
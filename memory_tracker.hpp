@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "interfaces/i_graph.hpp"
+
+namespace uni_course_cpp {
+
+struct HeapMemoryUsage {
+  size_t allocated_bytes = 0;
+  size_t peak_allocated_bytes = 0;
+  size_t allocations_count = 0;
+};
+
+struct ProcessMemoryUsage {
+  size_t rss_bytes = 0;
+  size_t peak_rss_bytes = 0;
+};
+
+HeapMemoryUsage get_heap_memory_usage();
+void reset_heap_peak();
+ProcessMemoryUsage get_process_memory_usage();
+
+namespace printing {
+std::string print_memory_size(size_t bytes);
+std::string print_graph_memory_usage(const GraphMemoryUsage& usage);
+std::string print_heap_memory_usage(const HeapMemoryUsage& usage);
+std::string print_process_memory_usage(const ProcessMemoryUsage& usage);
+}  // namespace printing
+
+}  // namespace uni_course_cpp
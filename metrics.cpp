@@ -0,0 +1,251 @@
+#include "metrics.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+using uni_course_cpp::Counter;
+using uni_course_cpp::Gauge;
+using uni_course_cpp::Metrics;
+
+static constexpr double kMicrosecondsInSecond = 1000000.0;
+static constexpr int kMetricValuePrecision = 15;
+const std::string kMetricPrefix = "uni_course_cpp_";
+const std::string kTemporaryFileExtension = ".tmp";
+
+struct CounterDescription {
+  Counter counter;
+  const char* name;
+  const char* help;
+  double scale;
+};
+
+constexpr std::array<CounterDescription, Metrics::kCountersCount>
+    kCounterDescriptions = {{
+        {Counter::GraphsCompleted, "graphs_completed_total",
+         "Generated graphs.", 1.0},
+        {Counter::GraphsCancelled, "graphs_cancelled_total",
+         "Graph generation jobs cancelled or over budget.", 1.0},
+        {Counter::VerticesGenerated, "vertices_generated_total",
+         "Vertices in generated graphs.", 1.0},
+        {Counter::EdgesGenerated, "edges_generated_total",
+         "Edges in generated graphs.", 1.0},
+        {Counter::WorkerBusyUs, "worker_busy_seconds_total",
+         "Time controller workers spent running jobs, including running "
+         "ones.",
+         kMicrosecondsInSecond},
+        {Counter::WorkerIdleUs, "worker_idle_seconds_total",
+         "Time controller workers spent polling the job queue without "
+         "getting a job.",
+         kMicrosecondsInSecond},
+        {Counter::JobsMutexWaitUs, "jobs_mutex_wait_seconds_total",
+         "Time spent waiting for the controller jobs mutex before taking a "
+         "job.",
+         kMicrosecondsInSecond},
+        {Counter::ColoredEdgesMutexWaitUs,
+         "colored_edges_mutex_wait_seconds_total",
+         "Time spent waiting for the colored edges mutex.",
+         kMicrosecondsInSecond},
+        {Counter::BytesWritten, "bytes_written_total",
+         "Bytes of graph output written to disk.", 1.0},
+    }};
+
+long long get_counter(const Metrics::CounterValues& values, Counter counter) {
+  return values[static_cast<int>(counter)];
+}
+
+long long get_time_us() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void print_metric(std::ostream& output,
+                  const std::string& name,
+                  const std::string& help,
+                  const std::string& type,
+                  double value) {
+  output << "# HELP " << kMetricPrefix << name << " " << help << "\n"
+         << "# TYPE " << kMetricPrefix << name << " " << type << "\n"
+         << kMetricPrefix << name << " " << value << "\n";
+}
+
+}  // namespace
+
+namespace uni_course_cpp {
+
+Metrics::ThreadSlot& Metrics::get_thread_slot() {
+  thread_local const int thread_slot_index =
+      next_thread_slot_index_.fetch_add(1, std::memory_order_relaxed) %
+      kThreadSlotsCount;
+  return thread_slots_[thread_slot_index];
+}
+
+void Metrics::add(Counter counter, long long value) {
+  get_thread_slot()
+      .counters[static_cast<int>(counter)]
+      .fetch_add(value, std::memory_order_relaxed);
+}
+
+void Metrics::set(Gauge gauge, long long value) {
+  gauges_[static_cast<int>(gauge)].store(value, std::memory_order_relaxed);
+}
+
+Metrics::ActivitySlot& Metrics::get_activity_slot() {
+  thread_local const int activity_slot_index =
+      next_activity_slot_index_.fetch_add(1, std::memory_order_relaxed) %
+      kThreadSlotsCount;
+  return activity_slots_[activity_slot_index];
+}
+
+void Metrics::begin_activity(Counter counter) {
+  end_activity();
+  auto& activity_slot = get_activity_slot();
+  activity_slot.start_time_us.store(get_time_us(), std::memory_order_relaxed);
+  activity_slot.counter.store(static_cast<int>(counter),
+                              std::memory_order_release);
+}
+
+void Metrics::end_activity() {
+  auto& activity_slot = get_activity_slot();
+  const auto counter = activity_slot.counter.load(std::memory_order_relaxed);
+  if (counter == kNoActivity)
+    return;
+  add(static_cast<Counter>(counter),
+      get_time_us() -
+          activity_slot.start_time_us.load(std::memory_order_relaxed));
+  activity_slot.counter.store(kNoActivity, std::memory_order_release);
+}
+
+Metrics::CounterValues Metrics::get_counter_values() const {
+  CounterValues values{};
+  for (const auto& thread_slot : thread_slots_) {
+    for (int i = 0; i < kCountersCount; ++i) {
+      values[i] += thread_slot.counters[i].load(std::memory_order_relaxed);
+    }
+  }
+  const auto time_us = get_time_us();
+  for (const auto& activity_slot : activity_slots_) {
+    const auto counter = activity_slot.counter.load(std::memory_order_acquire);
+    if (counter == kNoActivity)
+      continue;
+    values[counter] += std::max(
+        0LL, time_us -
+                 activity_slot.start_time_us.load(std::memory_order_relaxed));
+  }
+  return values;
+}
+
+Metrics::GaugeValues Metrics::get_gauge_values() const {
+  GaugeValues values{};
+  for (int i = 0; i < kGaugesCount; ++i) {
+    values[i] = gauges_[i].load(std::memory_order_relaxed);
+  }
+  return values;
+}
+
+TimedLockGuard::TimedLockGuard(std::mutex& mutex, Counter wait_counter)
+    : mutex_(mutex) {
+  if (mutex_.try_lock())
+    return;
+  const auto start_time = std::chrono::steady_clock::now();
+  mutex_.lock();
+  const auto wait_time = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start_time);
+  Metrics::get_metrics().add(wait_counter, wait_time.count());
+}
+
+void MetricsExporter::start() {
+  const std::lock_guard lock(mutex_);
+  if (is_working_)
+    return;
+  is_working_ = true;
+  should_terminate_ = false;
+  previous_counter_values_ = Metrics::get_metrics().get_counter_values();
+  previous_export_time_ = std::chrono::steady_clock::now();
+
+  thread_ = std::thread([this]() {
+    std::unique_lock lock(mutex_);
+    while (!should_terminate_) {
+      condition_.wait_for(lock, export_period_,
+                          [this]() { return should_terminate_; });
+      export_metrics(std::chrono::steady_clock::now());
+    }
+  });
+}
+
+void MetricsExporter::stop() {
+  {
+    const std::lock_guard lock(mutex_);
+    if (!is_working_)
+      return;
+    should_terminate_ = true;
+  }
+  condition_.notify_all();
+  thread_.join();
+  const std::lock_guard lock(mutex_);
+  is_working_ = false;
+}
+
+MetricsExporter::~MetricsExporter() {
+  stop();
+}
+
+void MetricsExporter::export_metrics(
+    std::chrono::steady_clock::time_point export_time) {
+  const auto counter_values = Metrics::get_metrics().get_counter_values();
+  const auto gauge_values = Metrics::get_metrics().get_gauge_values();
+  const double period_s =
+      std::chrono::duration<double>(export_time - previous_export_time_)
+          .count();
+  const auto get_increase = [this, &counter_values](Counter counter) {
+    return std::max(0LL, get_counter(counter_values, counter) -
+                             get_counter(previous_counter_values_, counter));
+  };
+  const auto get_rate = [&get_increase, period_s](Counter counter) {
+    if (period_s <= 0)
+      return 0.0;
+    return get_increase(counter) / period_s;
+  };
+  const auto busy_us = get_increase(Counter::WorkerBusyUs);
+  const auto idle_us = get_increase(Counter::WorkerIdleUs);
+
+  std::ostringstream metrics_stream;
+  metrics_stream.precision(kMetricValuePrecision);
+  for (const auto& description : kCounterDescriptions) {
+    print_metric(metrics_stream, description.name, description.help,
+                 "counter",
+                 get_counter(counter_values, description.counter) /
+                     description.scale);
+  }
+  print_metric(metrics_stream, "job_queue_depth",
+               "Jobs waiting in the controller queue.", "gauge",
+               gauge_values[static_cast<int>(Gauge::JobQueueDepth)]);
+  print_metric(metrics_stream, "vertices_per_second",
+               "Vertex generation rate over the last export period.", "gauge",
+               get_rate(Counter::VerticesGenerated));
+  print_metric(metrics_stream, "edges_per_second",
+               "Edge generation rate over the last export period.", "gauge",
+               get_rate(Counter::EdgesGenerated));
+  print_metric(metrics_stream, "worker_busy_ratio",
+               "Share of worker time spent running jobs over the last export "
+               "period.",
+               "gauge",
+               busy_us + idle_us > 0
+                   ? static_cast<double>(busy_us) / (busy_us + idle_us)
+                   : 0.0);
+
+  const auto temporary_path = file_path_ + kTemporaryFileExtension;
+  {
+    std::ofstream metrics_file(temporary_path);
+    metrics_file << metrics_stream.str();
+  }
+  std::rename(temporary_path.c_str(), file_path_.c_str());
+
+  previous_counter_values_ = counter_values;
+  previous_export_time_ = export_time;
+}
+
+}  // namespace uni_course_cpp
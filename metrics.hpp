@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "interfaces/i_worker.hpp"
+
+namespace uni_course_cpp {
+
+enum class Counter {
+  GraphsCompleted,
+  GraphsCancelled,
+  VerticesGenerated,
+  EdgesGenerated,
+  WorkerBusyUs,
+  WorkerIdleUs,
+  JobsMutexWaitUs,
+  ColoredEdgesMutexWaitUs,
+  BytesWritten,
+  Count
+};
+
+enum class Gauge { JobQueueDepth, Count };
+
+class Metrics {
+ public:
+  static constexpr int kCountersCount = static_cast<int>(Counter::Count);
+  static constexpr int kGaugesCount = static_cast<int>(Gauge::Count);
+
+  using CounterValues = std::array<long long, kCountersCount>;
+  using GaugeValues = std::array<long long, kGaugesCount>;
+
+  static Metrics& get_metrics() {
+    static Metrics singleton_metrics;
+    return singleton_metrics;
+  }
+
+  void add(Counter counter, long long value);
+  void set(Gauge gauge, long long value);
+  void begin_activity(Counter counter);
+  void end_activity();
+  CounterValues get_counter_values() const;
+  GaugeValues get_gauge_values() const;
+
+ private:
+  static constexpr int kThreadSlotsCount = 256;
+  static constexpr size_t kCacheLineSize = 64;
+
+  static constexpr int kNoActivity = -1;
+
+  struct alignas(kCacheLineSize) ThreadSlot {
+    std::array<std::atomic<long long>, kCountersCount> counters{};
+  };
+
+  // Time of an unfinished activity is added to its counter when sampled.
+  struct alignas(kCacheLineSize) ActivitySlot {
+    std::atomic<int> counter = kNoActivity;
+    std::atomic<long long> start_time_us = 0;
+  };
+
+  Metrics() = default;
+  ThreadSlot& get_thread_slot();
+  ActivitySlot& get_activity_slot();
+
+  std::array<ThreadSlot, kThreadSlotsCount> thread_slots_;
+  std::atomic<int> next_thread_slot_index_ = 0;
+  std::array<ActivitySlot, kThreadSlotsCount> activity_slots_;
+  std::atomic<int> next_activity_slot_index_ = 0;
+  std::array<std::atomic<long long>, kGaugesCount> gauges_{};
+
+  Metrics(const Metrics&) = delete;
+  Metrics& operator=(const Metrics&) = delete;
+  Metrics(Metrics&&) = delete;
+  Metrics& operator=(Metrics&&) = delete;
+};
+
+class TimedLockGuard {
+ public:
+  TimedLockGuard(std::mutex& mutex, Counter wait_counter);
+  ~TimedLockGuard() { mutex_.unlock(); }
+
+  TimedLockGuard(const TimedLockGuard&) = delete;
+  TimedLockGuard& operator=(const TimedLockGuard&) = delete;
+
+ private:
+  std::mutex& mutex_;
+};
+
+class MetricsExporter : IWorker {
+ public:
+  MetricsExporter(const std::string& file_path,
+                  std::chrono::milliseconds export_period)
+      : file_path_(file_path), export_period_(export_period) {}
+  ~MetricsExporter() override;
+
+  void start() override;
+  void stop() override;
+
+ private:
+  void export_metrics(std::chrono::steady_clock::time_point export_time);
+
+  std::string file_path_;
+  std::chrono::milliseconds export_period_;
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool should_terminate_ = false;
+  bool is_working_ = false;
+
+  Metrics::CounterValues previous_counter_values_{};
+  std::chrono::steady_clock::time_point previous_export_time_;
+};
+
+}  // namespace uni_course_cpp
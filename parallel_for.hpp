@@ -0,0 +1,38 @@
+#pragma once
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace uni_course_cpp {
+
+template <typename ChunkHandler>
+void parallel_for(int begin,
+                  int end,
+                  int threads_count,
+                  const ChunkHandler& chunk_handler) {
+  const int size = end - begin;
+  if (size <= 0)
+    return;
+  threads_count = std::max(1, std::min(threads_count, size));
+  const int chunk_size = (size + threads_count - 1) / threads_count;
+
+  auto threads = std::vector<std::thread>();
+  threads.reserve(threads_count - 1);
+  for (int i = 1; i < threads_count; ++i) {
+    const int chunk_begin = begin + i * chunk_size;
+    const int chunk_end = std::min(end, chunk_begin + chunk_size);
+    if (chunk_begin >= chunk_end)
+      break;
+    threads.emplace_back([&chunk_handler, i, chunk_begin, chunk_end]() {
+      chunk_handler(i, chunk_begin, chunk_end);
+    });
+  }
+  chunk_handler(0, begin, std::min(end, begin + chunk_size));
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace uni_course_cpp
@@ -0,0 +1,501 @@
+#include "shared_graph.hpp"
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using uni_course_cpp::EdgeId;
+using uni_course_cpp::GraphDepth;
+using uni_course_cpp::SharedGraphHeader;
+using uni_course_cpp::VertexId;
+
+static constexpr GraphDepth kDefaultDepth = 1;
+static constexpr size_t kArrayAlignment = 64;
+static constexpr size_t kMaxPidDigitsCount = 9;
+const std::string kSharedMemoryDirectoryPath = "/dev/shm/";
+
+size_t align_offset(size_t offset) {
+  return (offset + kArrayAlignment - 1) / kArrayAlignment * kArrayAlignment;
+}
+
+SharedGraphHeader get_shared_graph_header(GraphDepth depth,
+                                          int vertices_count,
+                                          int edges_count,
+                                          size_t adjacency_edge_ids_count) {
+  auto header = SharedGraphHeader();
+  header.depth = depth;
+  header.vertices_count = vertices_count;
+  header.edges_count = edges_count;
+
+  size_t offset = align_offset(sizeof(SharedGraphHeader));
+  const auto allocate = [&offset](size_t bytes) {
+    const auto array_offset = offset;
+    offset = align_offset(offset + bytes);
+    return array_offset;
+  };
+  header.vertex_depths_offset = allocate(vertices_count * sizeof(GraphDepth));
+  header.edge_from_vertex_ids_offset = allocate(edges_count * sizeof(VertexId));
+  header.edge_to_vertex_ids_offset = allocate(edges_count * sizeof(VertexId));
+  header.edge_colors_offset = allocate(edges_count * sizeof(std::uint8_t));
+  header.adjacency_offsets_offset =
+      allocate((vertices_count + 1) * sizeof(std::int64_t));
+  header.adjacency_edge_ids_offset =
+      allocate(adjacency_edge_ids_count * sizeof(EdgeId));
+  header.depth_offsets_offset = allocate((depth + 1) * sizeof(std::int32_t));
+  header.depth_vertex_ids_offset = allocate(vertices_count * sizeof(VertexId));
+  header.size_bytes = offset;
+  return header;
+}
+
+std::runtime_error shared_memory_error(const std::string& message,
+                                       const std::string& shm_name) {
+  return std::runtime_error(message + " " + shm_name + ": " +
+                            std::strerror(errno));
+}
+
+bool is_process_alive(pid_t pid) {
+  return kill(pid, 0) == 0 || errno == EPERM;
+}
+
+pid_t get_owner_pid(const std::string& file_name,
+                    const std::string& file_name_prefix) {
+  const auto pid_begin = file_name_prefix.size();
+  const auto pid_end = file_name.find('_', pid_begin);
+  if (pid_end == std::string::npos || pid_end == pid_begin ||
+      pid_end - pid_begin > kMaxPidDigitsCount ||
+      !std::all_of(file_name.cbegin() + pid_begin,
+                   file_name.cbegin() + pid_end, ::isdigit))
+    return 0;
+  return std::stoi(file_name.substr(pid_begin, pid_end - pid_begin));
+}
+
+}  // namespace
+
+namespace uni_course_cpp {
+
+size_t write_shared_graph(const IGraph& graph, const std::string& shm_name) {
+  const auto vertices_count = graph.vertices_count();
+  const auto edges_count = graph.edges_count();
+  const auto depth = graph.depth();
+
+  size_t adjacency_edge_ids_count = 0;
+  graph.for_each_vertex([&graph, &adjacency_edge_ids_count,
+                         vertices_count](const IVertex& vertex) {
+    if (vertex.id() < 0 || vertex.id() >= vertices_count) {
+      throw std::runtime_error("Graph vertex ids are not dense");
+    }
+    adjacency_edge_ids_count +=
+        graph.get_connected_edge_ids(vertex.id()).size();
+  });
+  int depth_vertices_count = 0;
+  for (GraphDepth current_depth = kDefaultDepth; current_depth <= depth;
+       ++current_depth) {
+    depth_vertices_count += graph.get_depth_vertex_ids(current_depth).size();
+  }
+  if (depth_vertices_count != vertices_count) {
+    throw std::runtime_error("Graph depths don't cover all vertices");
+  }
+  const auto header = get_shared_graph_header(depth, vertices_count,
+                                              edges_count,
+                                              adjacency_edge_ids_count);
+
+  const int file_descriptor =
+      shm_open(shm_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (file_descriptor < 0) {
+    throw shared_memory_error("Failed to create shared memory", shm_name);
+  }
+  if (ftruncate(file_descriptor, header.size_bytes) != 0) {
+    const auto error =
+        shared_memory_error("Failed to resize shared memory", shm_name);
+    close(file_descriptor);
+    shm_unlink(shm_name.c_str());
+    throw error;
+  }
+  void* const region = mmap(nullptr, header.size_bytes, PROT_READ | PROT_WRITE,
+                            MAP_SHARED, file_descriptor, 0);
+  close(file_descriptor);
+  if (region == MAP_FAILED) {
+    const auto error =
+        shared_memory_error("Failed to map shared memory", shm_name);
+    shm_unlink(shm_name.c_str());
+    throw error;
+  }
+
+  auto* const data = static_cast<std::byte*>(region);
+  const auto get_array = [data](std::uint64_t offset) {
+    return data + offset;
+  };
+  std::memcpy(data, &header, sizeof(header));
+
+  auto* const vertex_depths =
+      reinterpret_cast<GraphDepth*>(get_array(header.vertex_depths_offset));
+  auto* const adjacency_offsets = reinterpret_cast<std::int64_t*>(
+      get_array(header.adjacency_offsets_offset));
+  auto* const adjacency_edge_ids =
+      reinterpret_cast<EdgeId*>(get_array(header.adjacency_edge_ids_offset));
+  adjacency_offsets[0] = 0;
+  for (VertexId id = 0; id < vertices_count; ++id) {
+    vertex_depths[id] = graph.get_vertex_depth(id);
+    const auto& connected_edge_ids = graph.get_connected_edge_ids(id);
+    auto* const vertex_edge_ids = adjacency_edge_ids + adjacency_offsets[id];
+    std::copy(connected_edge_ids.cbegin(), connected_edge_ids.cend(),
+              vertex_edge_ids);
+    std::sort(vertex_edge_ids, vertex_edge_ids + connected_edge_ids.size());
+    adjacency_offsets[id + 1] =
+        adjacency_offsets[id] + connected_edge_ids.size();
+  }
+
+  auto* const edge_from_vertex_ids = reinterpret_cast<VertexId*>(
+      get_array(header.edge_from_vertex_ids_offset));
+  auto* const edge_to_vertex_ids =
+      reinterpret_cast<VertexId*>(get_array(header.edge_to_vertex_ids_offset));
+  auto* const edge_colors =
+      reinterpret_cast<std::uint8_t*>(get_array(header.edge_colors_offset));
+  graph.for_each_edge([edge_from_vertex_ids, edge_to_vertex_ids, edge_colors,
+                       edges_count](const IEdge& edge) {
+    if (edge.id() < 0 || edge.id() >= edges_count)
+      return;
+    edge_from_vertex_ids[edge.id()] = edge.from_vertex_id();
+    edge_to_vertex_ids[edge.id()] = edge.to_vertex_id();
+    edge_colors[edge.id()] = static_cast<std::uint8_t>(edge.color());
+  });
+
+  auto* const depth_offsets =
+      reinterpret_cast<std::int32_t*>(get_array(header.depth_offsets_offset));
+  auto* const depth_vertex_ids =
+      reinterpret_cast<VertexId*>(get_array(header.depth_vertex_ids_offset));
+  depth_offsets[0] = 0;
+  for (GraphDepth current_depth = kDefaultDepth; current_depth <= depth;
+       ++current_depth) {
+    const auto& current_depth_vertex_ids =
+        graph.get_depth_vertex_ids(current_depth);
+    const auto depth_begin = depth_offsets[current_depth - kDefaultDepth];
+    const auto depth_end = depth_begin + current_depth_vertex_ids.size();
+    std::copy(current_depth_vertex_ids.cbegin(),
+              current_depth_vertex_ids.cend(), depth_vertex_ids + depth_begin);
+    std::sort(depth_vertex_ids + depth_begin, depth_vertex_ids + depth_end);
+    depth_offsets[current_depth] = depth_end;
+  }
+
+  munmap(region, header.size_bytes);
+  return header.size_bytes;
+}
+
+void unlink_shared_graph(const std::string& shm_name) {
+  shm_unlink(shm_name.c_str());
+}
+
+int unlink_stale_shared_graphs(const std::string& shm_name_prefix) {
+  const auto file_name_prefix =
+      !shm_name_prefix.empty() && shm_name_prefix.front() == '/'
+          ? shm_name_prefix.substr(1)
+          : shm_name_prefix;
+  auto stale_file_names = std::vector<std::string>();
+  std::error_code error_code;
+  for (const auto& directory_entry : std::filesystem::directory_iterator(
+           kSharedMemoryDirectoryPath, error_code)) {
+    const auto file_name = directory_entry.path().filename().string();
+    if (file_name.rfind(file_name_prefix, 0) != 0)
+      continue;
+    const auto owner_pid = get_owner_pid(file_name, file_name_prefix);
+    if (owner_pid > 0 && !is_process_alive(owner_pid)) {
+      stale_file_names.push_back(file_name);
+    }
+  }
+
+  int unlinked_count = 0;
+  for (const auto& file_name : stale_file_names) {
+    if (shm_unlink(("/" + file_name).c_str()) == 0) {
+      ++unlinked_count;
+    }
+  }
+  return unlinked_count;
+}
+
+SharedGraphView::SharedGraphView(const std::string& shm_name) {
+  const int file_descriptor = shm_open(shm_name.c_str(), O_RDONLY, 0);
+  if (file_descriptor < 0) {
+    throw shared_memory_error("Failed to open shared memory", shm_name);
+  }
+  struct stat file_stat;
+  if (fstat(file_descriptor, &file_stat) != 0 ||
+      static_cast<size_t>(file_stat.st_size) < sizeof(SharedGraphHeader)) {
+    close(file_descriptor);
+    throw std::runtime_error("Shared memory " + shm_name +
+                             " doesn't contain a graph");
+  }
+  mapped_size_ = file_stat.st_size;
+  void* const region = mmap(nullptr, mapped_size_, PROT_READ, MAP_SHARED,
+                            file_descriptor, 0);
+  close(file_descriptor);
+  if (region == MAP_FAILED) {
+    throw shared_memory_error("Failed to map shared memory", shm_name);
+  }
+
+  data_ = static_cast<const std::byte*>(region);
+  header_ = reinterpret_cast<const SharedGraphHeader*>(data_);
+  try {
+    check_layout();
+  } catch (...) {
+    munmap(region, mapped_size_);
+    throw;
+  }
+
+  vertex_depths_ = get_array<GraphDepth>(header_->vertex_depths_offset);
+  edge_from_vertex_ids_ =
+      get_array<VertexId>(header_->edge_from_vertex_ids_offset);
+  edge_to_vertex_ids_ = get_array<VertexId>(header_->edge_to_vertex_ids_offset);
+  edge_colors_ = get_array<std::uint8_t>(header_->edge_colors_offset);
+  adjacency_offsets_ =
+      get_array<std::int64_t>(header_->adjacency_offsets_offset);
+  adjacency_edge_ids_ = get_array<EdgeId>(header_->adjacency_edge_ids_offset);
+  depth_offsets_ = get_array<std::int32_t>(header_->depth_offsets_offset);
+  depth_vertex_ids_ = get_array<VertexId>(header_->depth_vertex_ids_offset);
+}
+
+SharedGraphView::~SharedGraphView() {
+  munmap(const_cast<std::byte*>(data_), mapped_size_);
+}
+
+void SharedGraphView::check_layout() const {
+  if (header_->magic != SharedGraphHeader::kMagic ||
+      header_->version != SharedGraphHeader::kVersion) {
+    throw std::runtime_error("Unsupported shared graph format");
+  }
+  if (header_->size_bytes != mapped_size_ || header_->vertices_count < 0 ||
+      header_->edges_count < 0 || header_->depth < 0) {
+    throw std::runtime_error("Corrupted shared graph header");
+  }
+
+  const auto vertices_count = header_->vertices_count;
+  const auto edges_count = header_->edges_count;
+  const auto depth = header_->depth;
+  const auto adjacency_offsets_offset = header_->adjacency_offsets_offset;
+  if (adjacency_offsets_offset < sizeof(SharedGraphHeader) ||
+      adjacency_offsets_offset > mapped_size_ ||
+      (vertices_count + 1) * sizeof(std::int64_t) >
+          mapped_size_ - adjacency_offsets_offset) {
+    throw std::runtime_error("Shared graph array is out of bounds");
+  }
+
+  const auto* const adjacency_offsets =
+      get_array<std::int64_t>(adjacency_offsets_offset);
+  if (adjacency_offsets[0] != 0) {
+    throw std::runtime_error("Corrupted shared graph adjacency offsets");
+  }
+  for (VertexId id = 0; id < vertices_count; ++id) {
+    if (adjacency_offsets[id + 1] < adjacency_offsets[id] ||
+        static_cast<std::uint64_t>(adjacency_offsets[id + 1]) >
+            mapped_size_ / sizeof(EdgeId)) {
+      throw std::runtime_error("Corrupted shared graph adjacency offsets");
+    }
+  }
+
+  const auto expected_header =
+      get_shared_graph_header(depth, vertices_count, edges_count,
+                              adjacency_offsets[vertices_count]);
+  if (expected_header.size_bytes != header_->size_bytes ||
+      expected_header.vertex_depths_offset != header_->vertex_depths_offset ||
+      expected_header.edge_from_vertex_ids_offset !=
+          header_->edge_from_vertex_ids_offset ||
+      expected_header.edge_to_vertex_ids_offset !=
+          header_->edge_to_vertex_ids_offset ||
+      expected_header.edge_colors_offset != header_->edge_colors_offset ||
+      expected_header.adjacency_offsets_offset != adjacency_offsets_offset ||
+      expected_header.adjacency_edge_ids_offset !=
+          header_->adjacency_edge_ids_offset ||
+      expected_header.depth_offsets_offset != header_->depth_offsets_offset ||
+      expected_header.depth_vertex_ids_offset !=
+          header_->depth_vertex_ids_offset) {
+    throw std::runtime_error("Corrupted shared graph layout");
+  }
+
+  const auto* const adjacency_edge_ids =
+      get_array<EdgeId>(header_->adjacency_edge_ids_offset);
+  for (std::int64_t i = 0; i < adjacency_offsets[vertices_count]; ++i) {
+    if (adjacency_edge_ids[i] < 0 || adjacency_edge_ids[i] >= edges_count) {
+      throw std::runtime_error("Corrupted shared graph adjacency list");
+    }
+  }
+
+  const auto* const edge_from_vertex_ids =
+      get_array<VertexId>(header_->edge_from_vertex_ids_offset);
+  const auto* const edge_to_vertex_ids =
+      get_array<VertexId>(header_->edge_to_vertex_ids_offset);
+  const auto* const edge_colors =
+      get_array<std::uint8_t>(header_->edge_colors_offset);
+  for (EdgeId id = 0; id < edges_count; ++id) {
+    if (edge_from_vertex_ids[id] < 0 ||
+        edge_from_vertex_ids[id] >= vertices_count ||
+        edge_to_vertex_ids[id] < 0 ||
+        edge_to_vertex_ids[id] >= vertices_count ||
+        edge_colors[id] > static_cast<std::uint8_t>(EdgeColor::Red)) {
+      throw std::runtime_error("Corrupted shared graph edges");
+    }
+  }
+
+  const auto* const depth_offsets =
+      get_array<std::int32_t>(header_->depth_offsets_offset);
+  if (depth_offsets[0] != 0) {
+    throw std::runtime_error("Corrupted shared graph depth offsets");
+  }
+  for (GraphDepth current_depth = kDefaultDepth; current_depth <= depth;
+       ++current_depth) {
+    if (depth_offsets[current_depth] <
+            depth_offsets[current_depth - kDefaultDepth] ||
+        depth_offsets[current_depth] > vertices_count) {
+      throw std::runtime_error("Corrupted shared graph depth offsets");
+    }
+  }
+  const auto* const depth_vertex_ids =
+      get_array<VertexId>(header_->depth_vertex_ids_offset);
+  for (std::int32_t i = 0; i < depth_offsets[depth]; ++i) {
+    if (depth_vertex_ids[i] < 0 || depth_vertex_ids[i] >= vertices_count) {
+      throw std::runtime_error("Corrupted shared graph depth vertex ids");
+    }
+  }
+}
+
+void SharedGraphView::check_vertex_id(VertexId id) const {
+  if (id < 0 || id >= vertices_count()) {
+    throw std::runtime_error("Vertex doesn't exist");
+  }
+}
+
+VertexId SharedGraphView::add_vertex() {
+  throw std::runtime_error("Shared graph view is read-only");
+}
+
+EdgeId SharedGraphView::add_edge(VertexId, VertexId) {
+  throw std::runtime_error("Shared graph view is read-only");
+}
+
+bool SharedGraphView::are_connected(VertexId from_vertex_id,
+                                    VertexId to_vertex_id) const {
+  check_vertex_id(from_vertex_id);
+  check_vertex_id(to_vertex_id);
+  for (auto i = adjacency_offsets_[from_vertex_id];
+       i < adjacency_offsets_[from_vertex_id + 1]; ++i) {
+    const auto edge_id = adjacency_edge_ids_[i];
+    const auto edge_from_vertex_id = edge_from_vertex_ids_[edge_id];
+    const auto edge_to_vertex_id = edge_to_vertex_ids_[edge_id];
+    if (from_vertex_id == to_vertex_id) {
+      if (static_cast<EdgeColor>(edge_colors_[edge_id]) == EdgeColor::Green)
+        return true;
+    } else if (edge_from_vertex_id == to_vertex_id ||
+               edge_to_vertex_id == to_vertex_id) {
+      return true;
+    }
+  }
+  return false;
+}
+
+GraphDepth SharedGraphView::get_vertex_depth(VertexId id) const {
+  check_vertex_id(id);
+  return vertex_depths_[id];
+}
+
+const std::unordered_set<EdgeId>& SharedGraphView::get_connected_edge_ids(
+    VertexId id) const {
+  check_vertex_id(id);
+  const std::lock_guard lock(cache_mutex_);
+  const auto [it, is_inserted] = connected_edge_ids_cache_.try_emplace(id);
+  if (is_inserted) {
+    it->second.insert(adjacency_edge_ids_ + adjacency_offsets_[id],
+                      adjacency_edge_ids_ + adjacency_offsets_[id + 1]);
+  }
+  return it->second;
+}
+
+const std::vector<SharedGraphView::VertexView>& SharedGraphView::get_vertices()
+    const {
+  const std::lock_guard lock(cache_mutex_);
+  if (vertices_cache_.empty()) {
+    vertices_cache_.reserve(vertices_count());
+    for (VertexId id = 0; id < vertices_count(); ++id) {
+      vertices_cache_.emplace_back(id);
+    }
+  }
+  return vertices_cache_;
+}
+
+const std::vector<SharedGraphView::EdgeView>& SharedGraphView::get_edges()
+    const {
+  const std::lock_guard lock(cache_mutex_);
+  if (edges_cache_.empty()) {
+    edges_cache_.reserve(edges_count());
+    for (EdgeId id = 0; id < edges_count(); ++id) {
+      edges_cache_.emplace_back(id, edge_from_vertex_ids_[id],
+                                edge_to_vertex_ids_[id],
+                                static_cast<EdgeColor>(edge_colors_[id]));
+    }
+  }
+  return edges_cache_;
+}
+
+void SharedGraphView::for_each_vertex(
+    const std::function<void(const IVertex& vertex)>& handler) const {
+  for (const auto& vertex : get_vertices()) {
+    handler(vertex);
+  }
+}
+
+void SharedGraphView::for_each_edge(
+    const std::function<void(const IEdge& edge)>& handler) const {
+  for (const auto& edge : get_edges()) {
+    handler(edge);
+  }
+}
+
+const std::unordered_set<VertexId>& SharedGraphView::get_depth_vertex_ids(
+    GraphDepth depth) const {
+  if (depth < kDefaultDepth || depth > this->depth()) {
+    throw std::runtime_error("Depth doesn't exist");
+  }
+  const std::lock_guard lock(cache_mutex_);
+  const auto [it, is_inserted] = depth_vertex_ids_cache_.try_emplace(depth);
+  if (is_inserted) {
+    it->second.insert(depth_vertex_ids_ + depth_offsets_[depth - kDefaultDepth],
+                      depth_vertex_ids_ + depth_offsets_[depth]);
+  }
+  return it->second;
+}
+
+std::optional<VertexRange> SharedGraphView::get_depth_vertex_range(
+    GraphDepth depth) const {
+  if (depth < kDefaultDepth || depth > this->depth())
+    return std::nullopt;
+  const auto depth_begin = depth_offsets_[depth - kDefaultDepth];
+  const auto depth_end = depth_offsets_[depth];
+  if (depth_begin == depth_end)
+    return std::nullopt;
+  const auto first_vertex_id = depth_vertex_ids_[depth_begin];
+  const auto last_vertex_id = depth_vertex_ids_[depth_end - 1];
+  if (last_vertex_id - first_vertex_id != depth_end - depth_begin - 1)
+    return std::nullopt;
+  return VertexRange{first_vertex_id, last_vertex_id + 1};
+}
+
+GraphMemoryUsage SharedGraphView::memory_usage() const {
+  auto usage = GraphMemoryUsage();
+  usage.edges_bytes =
+      header_->adjacency_offsets_offset - header_->edge_from_vertex_ids_offset;
+  usage.vertex_depths_bytes =
+      header_->edge_from_vertex_ids_offset - header_->vertex_depths_offset;
+  usage.adjacency_list_bytes =
+      header_->depth_offsets_offset - header_->adjacency_offsets_offset;
+  usage.depth_vertex_ids_bytes =
+      header_->size_bytes - header_->depth_offsets_offset;
+  return usage;
+}
+
+}  // namespace uni_course_cpp
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "interfaces/i_graph.hpp"
+
+namespace uni_course_cpp {
+
+struct SharedGraphHeader {
+  static constexpr std::uint64_t kMagic = 0x48505247'43435355;
+  static constexpr std::uint32_t kVersion = 1;
+
+  std::uint64_t magic = kMagic;
+  std::uint32_t version = kVersion;
+  std::int32_t depth = 0;
+  std::int32_t vertices_count = 0;
+  std::int32_t edges_count = 0;
+  std::uint64_t size_bytes = 0;
+  std::uint64_t vertex_depths_offset = 0;
+  std::uint64_t edge_from_vertex_ids_offset = 0;
+  std::uint64_t edge_to_vertex_ids_offset = 0;
+  std::uint64_t edge_colors_offset = 0;
+  std::uint64_t adjacency_offsets_offset = 0;
+  std::uint64_t adjacency_edge_ids_offset = 0;
+  std::uint64_t depth_offsets_offset = 0;
+  std::uint64_t depth_vertex_ids_offset = 0;
+};
+
+size_t write_shared_graph(const IGraph& graph, const std::string& shm_name);
+void unlink_shared_graph(const std::string& shm_name);
+int unlink_stale_shared_graphs(const std::string& shm_name_prefix);
+
+// Reads the flat arrays in place. The hash set getters required by IGraph
+// (get_connected_edge_ids, get_depth_vertex_ids) and for_each_vertex/edge
+// are not zero-copy: they build per-view caches on first use. Prefer
+// get_depth_vertex_range and are_connected on the hot path.
+class SharedGraphView : public IGraph {
+ public:
+  explicit SharedGraphView(const std::string& shm_name);
+  SharedGraphView(const SharedGraphView&) = delete;
+  SharedGraphView& operator=(const SharedGraphView&) = delete;
+  ~SharedGraphView() override;
+
+  VertexId add_vertex() override;
+  EdgeId add_edge(VertexId from_vertex_id, VertexId to_vertex_id) override;
+  bool are_connected(VertexId from_vertex_id,
+                     VertexId to_vertex_id) const override;
+  GraphDepth get_vertex_depth(VertexId id) const override;
+  GraphDepth depth() const override { return header_->depth; }
+  const std::unordered_set<EdgeId>& get_connected_edge_ids(
+      VertexId id) const override;
+  int vertices_count() const override { return header_->vertices_count; }
+  int edges_count() const override { return header_->edges_count; }
+  void for_each_vertex(
+      const std::function<void(const IVertex& vertex)>& handler) const override;
+  void for_each_edge(
+      const std::function<void(const IEdge& edge)>& handler) const override;
+  const std::unordered_set<VertexId>& get_depth_vertex_ids(
+      GraphDepth depth) const override;
+  std::optional<VertexRange> get_depth_vertex_range(
+      GraphDepth depth) const override;
+  GraphMemoryUsage memory_usage() const override;
+
+  size_t size_bytes() const { return header_->size_bytes; }
+
+ private:
+  struct VertexView : IVertex {
+   public:
+    explicit VertexView(VertexId init_id) : id_(init_id) {}
+
+    VertexId id() const override { return id_; }
+
+   private:
+    const VertexId id_ = 0;
+  };
+
+  struct EdgeView : IEdge {
+   public:
+    EdgeView(EdgeId init_id,
+             VertexId init_from_vertex_id,
+             VertexId init_to_vertex_id,
+             EdgeColor init_color)
+        : id_(init_id),
+          from_vertex_id_(init_from_vertex_id),
+          to_vertex_id_(init_to_vertex_id),
+          color_(init_color) {}
+    EdgeId id() const override { return id_; }
+    VertexId from_vertex_id() const override { return from_vertex_id_; }
+    VertexId to_vertex_id() const override { return to_vertex_id_; }
+    EdgeColor color() const override { return color_; }
+
+   private:
+    const EdgeId id_ = 0;
+    const VertexId from_vertex_id_ = 0;
+    const VertexId to_vertex_id_ = 0;
+    const EdgeColor color_ = EdgeColor::Grey;
+  };
+
+  template <typename T>
+  const T* get_array(std::uint64_t offset) const {
+    return reinterpret_cast<const T*>(data_ + offset);
+  }
+  void check_vertex_id(VertexId id) const;
+  const std::vector<VertexView>& get_vertices() const;
+  const std::vector<EdgeView>& get_edges() const;
+  void check_layout() const;
+
+  const std::byte* data_ = nullptr;
+  const SharedGraphHeader* header_ = nullptr;
+  size_t mapped_size_ = 0;
+
+  const GraphDepth* vertex_depths_ = nullptr;
+  const VertexId* edge_from_vertex_ids_ = nullptr;
+  const VertexId* edge_to_vertex_ids_ = nullptr;
+  const std::uint8_t* edge_colors_ = nullptr;
+  const std::int64_t* adjacency_offsets_ = nullptr;
+  const EdgeId* adjacency_edge_ids_ = nullptr;
+  const std::int32_t* depth_offsets_ = nullptr;
+  const VertexId* depth_vertex_ids_ = nullptr;
+
+  mutable std::mutex cache_mutex_;
+  mutable std::vector<VertexView> vertices_cache_;
+  mutable std::vector<EdgeView> edges_cache_;
+  mutable std::unordered_map<VertexId, std::unordered_set<EdgeId>>
+      connected_edge_ids_cache_;
+  mutable std::unordered_map<GraphDepth, std::unordered_set<VertexId>>
+      depth_vertex_ids_cache_;
+};
+
+}  // namespace uni_course_cpp
@@ -0,0 +1,169 @@
+#include "shared_graph_queue.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace {
+
+static constexpr std::uint64_t kQueueMagic = 0x45555551'48505247;
+static constexpr std::uint32_t kQueueVersion = 1;
+
+std::runtime_error shared_memory_error(const std::string& message,
+                                       const std::string& name) {
+  return std::runtime_error(message + " " + name + ": " +
+                            std::strerror(errno));
+}
+
+}  // namespace
+
+namespace uni_course_cpp {
+
+SharedGraphDescriptor::SharedGraphDescriptor(int init_index,
+                                             size_t init_size_bytes,
+                                             const std::string& init_shm_name)
+    : index(init_index), size_bytes(init_size_bytes) {
+  if (init_shm_name.size() >= kMaxNameLength) {
+    throw std::runtime_error("Shared graph name is too long");
+  }
+  std::copy(init_shm_name.cbegin(), init_shm_name.cend(), shm_name);
+}
+
+size_t SharedGraphQueue::get_region_size(int capacity) {
+  return sizeof(Control) + capacity * sizeof(Cell);
+}
+
+SharedGraphQueue::SharedGraphQueue(const std::string& name, int capacity)
+    : capacity_(capacity) {
+  if (capacity_ <= 0 || (capacity_ & (capacity_ - 1)) != 0) {
+    throw std::runtime_error("Shared graph queue capacity has to be a power "
+                             "of two");
+  }
+  const int file_descriptor =
+      shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (file_descriptor < 0) {
+    throw shared_memory_error("Failed to create shared graph queue", name);
+  }
+  const auto region_size = get_region_size(capacity_);
+  if (ftruncate(file_descriptor, region_size) != 0) {
+    const auto error =
+        shared_memory_error("Failed to resize shared graph queue", name);
+    close(file_descriptor);
+    shm_unlink(name.c_str());
+    throw error;
+  }
+  try {
+    map_region(file_descriptor, region_size);
+  } catch (...) {
+    shm_unlink(name.c_str());
+    throw;
+  }
+
+  control_ = new (region_) Control();
+  cells_ = reinterpret_cast<Cell*>(static_cast<std::byte*>(region_) +
+                                   sizeof(Control));
+  for (int i = 0; i < capacity_; ++i) {
+    new (cells_ + i) Cell();
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  control_->capacity = capacity_;
+  control_->version = kQueueVersion;
+  std::atomic_thread_fence(std::memory_order_release);
+  control_->magic = kQueueMagic;
+}
+
+SharedGraphQueue::SharedGraphQueue(const std::string& name) {
+  const int file_descriptor = shm_open(name.c_str(), O_RDWR, 0);
+  if (file_descriptor < 0) {
+    throw shared_memory_error("Failed to open shared graph queue", name);
+  }
+  struct stat file_stat;
+  if (fstat(file_descriptor, &file_stat) != 0 ||
+      static_cast<size_t>(file_stat.st_size) < sizeof(Control)) {
+    close(file_descriptor);
+    throw std::runtime_error("Shared memory " + name +
+                             " doesn't contain a graph queue");
+  }
+  map_region(file_descriptor, file_stat.st_size);
+
+  control_ = static_cast<Control*>(region_);
+  cells_ = reinterpret_cast<Cell*>(static_cast<std::byte*>(region_) +
+                                   sizeof(Control));
+  capacity_ = control_->capacity;
+  if (control_->magic != kQueueMagic || control_->version != kQueueVersion ||
+      get_region_size(capacity_) != region_size_) {
+    munmap(region_, region_size_);
+    throw std::runtime_error("Unsupported shared graph queue format");
+  }
+}
+
+void SharedGraphQueue::map_region(int file_descriptor, size_t region_size) {
+  region_ = mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                 file_descriptor, 0);
+  close(file_descriptor);
+  if (region_ == MAP_FAILED) {
+    throw std::runtime_error(
+        std::string("Failed to map shared graph queue: ") +
+        std::strerror(errno));
+  }
+  region_size_ = region_size;
+}
+
+SharedGraphQueue::~SharedGraphQueue() {
+  munmap(region_, region_size_);
+}
+
+bool SharedGraphQueue::try_push(const SharedGraphDescriptor& descriptor) {
+  const std::uint64_t mask = capacity_ - 1;
+  auto position = control_->enqueue_position.load(std::memory_order_relaxed);
+  while (true) {
+    auto& cell = cells_[position & mask];
+    const auto sequence = cell.sequence.load(std::memory_order_acquire);
+    const auto difference = static_cast<std::int64_t>(sequence - position);
+    if (difference == 0) {
+      if (control_->enqueue_position.compare_exchange_weak(
+              position, position + 1, std::memory_order_relaxed)) {
+        cell.descriptor = descriptor;
+        cell.sequence.store(position + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (difference < 0) {
+      return false;
+    } else {
+      position = control_->enqueue_position.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+std::optional<SharedGraphDescriptor> SharedGraphQueue::try_pop() {
+  const std::uint64_t mask = capacity_ - 1;
+  auto position = control_->dequeue_position.load(std::memory_order_relaxed);
+  while (true) {
+    auto& cell = cells_[position & mask];
+    const auto sequence = cell.sequence.load(std::memory_order_acquire);
+    const auto difference = static_cast<std::int64_t>(sequence - position - 1);
+    if (difference == 0) {
+      if (control_->dequeue_position.compare_exchange_weak(
+              position, position + 1, std::memory_order_relaxed)) {
+        const auto descriptor = cell.descriptor;
+        cell.sequence.store(position + mask + 1, std::memory_order_release);
+        return descriptor;
+      }
+    } else if (difference < 0) {
+      return std::nullopt;
+    } else {
+      position = control_->dequeue_position.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void SharedGraphQueue::unlink(const std::string& name) {
+  shm_unlink(name.c_str());
+}
+
+}  // namespace uni_course_cpp
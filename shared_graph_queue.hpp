@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace uni_course_cpp {
+
+struct SharedGraphDescriptor {
+  static constexpr size_t kMaxNameLength = 64;
+
+  std::int32_t index = 0;
+  std::uint64_t size_bytes = 0;
+  char shm_name[kMaxNameLength] = {};
+
+  SharedGraphDescriptor() = default;
+  SharedGraphDescriptor(int init_index,
+                        size_t init_size_bytes,
+                        const std::string& init_shm_name);
+  std::string name() const { return shm_name; }
+};
+
+class SharedGraphQueue {
+ public:
+  SharedGraphQueue(const std::string& name, int capacity);
+  explicit SharedGraphQueue(const std::string& name);
+  SharedGraphQueue(const SharedGraphQueue&) = delete;
+  SharedGraphQueue& operator=(const SharedGraphQueue&) = delete;
+  ~SharedGraphQueue();
+
+  bool try_push(const SharedGraphDescriptor& descriptor);
+  std::optional<SharedGraphDescriptor> try_pop();
+  int capacity() const { return capacity_; }
+
+  static void unlink(const std::string& name);
+
+ private:
+  static constexpr size_t kCacheLineSize = 64;
+  static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                "Shared graph queue requires lock-free 64-bit atomics");
+
+  struct Control {
+    std::uint64_t magic = 0;
+    std::uint32_t version = 0;
+    std::uint32_t capacity = 0;
+    alignas(kCacheLineSize) std::atomic<std::uint64_t> enqueue_position = 0;
+    alignas(kCacheLineSize) std::atomic<std::uint64_t> dequeue_position = 0;
+  };
+
+  struct alignas(kCacheLineSize) Cell {
+    std::atomic<std::uint64_t> sequence = 0;
+    SharedGraphDescriptor descriptor;
+  };
+
+  static size_t get_region_size(int capacity);
+  void map_region(int file_descriptor, size_t region_size);
+
+  void* region_ = nullptr;
+  size_t region_size_ = 0;
+  Control* control_ = nullptr;
+  Cell* cells_ = nullptr;
+  int capacity_ = 0;
+};
+
+}  // namespace uni_course_cpp
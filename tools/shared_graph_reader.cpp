@@ -0,0 +1,66 @@
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "config.hpp"
+#include "graph_printer.hpp"
+#include "graph_validator.hpp"
+#include "shared_graph.hpp"
+#include "shared_graph_queue.hpp"
+
+namespace {
+
+static const int kMaxThreadsCount =
+    std::max(1u, std::thread::hardware_concurrency());
+
+std::string shared_graph_string(
+    const uni_course_cpp::SharedGraphDescriptor& descriptor,
+    const uni_course_cpp::SharedGraphView& graph,
+    const uni_course_cpp::ValidationReport& report) {
+  std::stringstream output;
+  output << "Graph " << descriptor.index << ", " << descriptor.name()
+         << ", size: " << graph.size_bytes()
+         << " B, " << uni_course_cpp::printing::print_graph(graph) << ", "
+         << uni_course_cpp::printing::print_validation_report(report);
+  return output.str();
+}
+
+}  // namespace
+
+int main() {
+  std::optional<uni_course_cpp::SharedGraphQueue> queue;
+  try {
+    queue.emplace(uni_course_cpp::config::kSharedGraphQueueName);
+  } catch (const std::exception& error) {
+    std::cerr << error.what() << std::endl;
+    return 1;
+  }
+
+  int graphs_count = 0;
+  int invalid_graphs_count = 0;
+  while (const auto descriptor = queue->try_pop()) {
+    ++graphs_count;
+    try {
+      const auto graph = uni_course_cpp::SharedGraphView(descriptor->name());
+      const auto report =
+          uni_course_cpp::validate_graph(graph, kMaxThreadsCount);
+      if (!report.is_valid()) {
+        ++invalid_graphs_count;
+      }
+      std::cout << shared_graph_string(*descriptor, graph, report)
+                << std::endl;
+    } catch (const std::exception& error) {
+      ++invalid_graphs_count;
+      std::cerr << "Graph " << descriptor->index << ", " << error.what()
+                << std::endl;
+    }
+    uni_course_cpp::unlink_shared_graph(descriptor->name());
+  }
+
+  std::cout << "Read graphs: " << graphs_count
+            << ", invalid: " << invalid_graphs_count << std::endl;
+  return invalid_graphs_count == 0 ? 0 : 1;
+}